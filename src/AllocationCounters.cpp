@@ -0,0 +1,66 @@
+#include "AllocationCounters.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using std::vector;
+using std::cout;
+using std::fixed;
+using std::setprecision;
+using std::setw;
+using std::left;
+using std::max;
+using std::memory_order_relaxed;
+
+using namespace GeneticSimulation;
+
+// constructor
+GeneticSimulation::ThreadAllocationCounters::ThreadAllocationCounters()
+{
+	for (auto& a : allocations) {
+		a.store(0, memory_order_relaxed);
+	}
+}
+
+// constructor which takes the number of simulation threads
+GeneticSimulation::AllocationCounters::AllocationCounters(unsigned int threads) :
+	threads(max(1u, threads)) {}
+
+// get counters of a simulation thread
+ThreadAllocationCounters& GeneticSimulation::AllocationCounters::get_thread(unsigned int i)
+{
+	return threads[i];
+}
+
+// get total allocations in each bucket across all threads so far
+vector<unsigned long long> GeneticSimulation::AllocationCounters::snapshot() const
+{
+	vector<unsigned long long> totals(num_phases + 1, 0);
+	for (auto& t : threads) {
+		for (unsigned int b = 0; b <= num_phases; b++) {
+			totals[b] += t.allocations[b].load(memory_order_relaxed);
+		}
+	}
+	return totals;
+}
+
+// print allocations per phase per timestep since a snapshot, returning total allocations
+unsigned long long GeneticSimulation::AllocationCounters::print_report(
+	const vector<unsigned long long>& since, unsigned long long timesteps) const
+{
+	// get current totals
+	auto totals = snapshot();
+	// total allocations since snapshot
+	unsigned long long total = 0;
+
+	cout << "Heap allocations per timestep over " << timesteps << " timesteps:\n" << fixed << setprecision(3);
+	for (unsigned int b = 0; b <= num_phases; b++) {
+		auto allocations = totals[b] - (since.empty() ? 0 : since[b]);
+		total += allocations;
+		auto name = b < num_phases ? get_phase_name(static_cast<simulation_phase>(b)) : "waiting";
+		cout << "  " << left << setw(22) << name
+			<< static_cast<double>(allocations) / max(1ull, timesteps) << " (" << allocations << " total)\n";
+	}
+
+	return total;
+}
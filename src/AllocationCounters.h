@@ -0,0 +1,48 @@
+#pragma once
+
+#include "SimulationPhase.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace GeneticSimulation
+{
+	// Heap allocations made by a single simulation thread in each phase, plus
+	// a final bucket for allocations made while waiting on other threads
+	struct alignas(64) ThreadAllocationCounters
+	{
+		// index of bucket for allocations made while waiting
+		static constexpr unsigned int wait_bucket = num_phases;
+
+		// constructor
+		ThreadAllocationCounters();
+
+		// number of allocations in each bucket
+		std::array<std::atomic<unsigned long long>, num_phases + 1> allocations;
+	};
+
+	// Per-thread counters of heap allocations made in each phase of the timestep
+	// loop, which are only non-zero in builds with allocation tracking enabled
+	class AllocationCounters
+	{
+	public:
+
+		// constructor which takes the number of simulation threads
+		explicit AllocationCounters(unsigned int threads);
+
+		// get counters of a simulation thread
+		ThreadAllocationCounters& get_thread(unsigned int i);
+
+		// get total allocations in each bucket across all threads so far
+		std::vector<unsigned long long> snapshot() const;
+
+		// print allocations per phase per timestep since a snapshot, returning total allocations
+		unsigned long long print_report(const std::vector<unsigned long long>& since,
+			unsigned long long timesteps) const;
+
+	private:
+
+		// counters for each thread
+		std::vector<ThreadAllocationCounters> threads;
+	};
+}
@@ -0,0 +1,117 @@
+#include "ComputeBackend.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <thread>
+#include <iostream>
+#ifdef PARALLEL_ALGORITHMS_SUPPORT
+#include <execution>
+#endif
+
+using std::min;
+using std::vector;
+
+// get name of a compute backend
+const char* GeneticSimulation::get_compute_backend_name(compute_backend b)
+{
+	switch (b) {
+	case threads_backend: return "threads";
+	case openmp_backend: return "openmp";
+	case parallel_backend: return "parallel";
+	default: return "unknown";
+	}
+}
+
+// get compute backend from its name (threads backend if not recognized)
+GeneticSimulation::compute_backend GeneticSimulation::parse_compute_backend(const std::string& name)
+{
+	for (unsigned int b = 0; b < num_compute_backends; b++) {
+		if (name == get_compute_backend_name(static_cast<compute_backend>(b))) {
+			return static_cast<compute_backend>(b);
+		}
+	}
+	std::cerr << "Unknown compute backend: " << name << ", using threads\n";
+	return threads_backend;
+}
+
+// get whether a compute backend was enabled when building
+bool GeneticSimulation::get_compute_backend_available(compute_backend b)
+{
+	switch (b) {
+	case threads_backend:
+		return true;
+	case openmp_backend:
+#ifdef _OPENMP
+		return true;
+#else
+		return false;
+#endif
+	case parallel_backend:
+#ifdef PARALLEL_ALGORITHMS_SUPPORT
+		return true;
+#else
+		return false;
+#endif
+	default:
+		return false;
+	}
+}
+
+// call a function with the y and t ranges of each tile covering height by width cells, in parallel
+// using the given backend, returning whether the backend was available
+bool GeneticSimulation::parallel_for_tiles(compute_backend backend, unsigned int worker_threads, unsigned int height,
+	unsigned int width, unsigned int tile_height, unsigned int tile_width,
+	const std::function<void(unsigned int start_y, unsigned int end_y, unsigned int start_t, unsigned int end_t)>& f)
+{
+	if (!get_compute_backend_available(backend)) return false;
+
+	// number of tiles down and across, and function calling f for a tile index
+	int tiles_y = static_cast<int>((height + tile_height - 1) / tile_height);
+	int tiles_t = static_cast<int>((width + tile_width - 1) / tile_width);
+	int num_tiles = tiles_y * tiles_t;
+	auto run_tile = [&](int i) {
+		unsigned int start_y = (i / tiles_t) * tile_height;
+		unsigned int start_t = (i % tiles_t) * tile_width;
+		f(start_y, min(height, start_y + tile_height), start_t, min(width, start_t + tile_width));
+	};
+
+	switch (backend) {
+	case openmp_backend: {
+		// tiles are flattened into one loop with a signed index, as required by older OpenMP versions
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(worker_threads)
+#endif
+		for (int i = 0; i < num_tiles; i++) {
+			run_tile(i);
+		}
+		break;
+	}
+	case parallel_backend: {
+#ifdef PARALLEL_ALGORITHMS_SUPPORT
+		// the parallel policy decides the number of threads itself, and is not unsequenced as 
+		// tiles allocate scratch memory (each tile is vectorized by the kernel it runs)
+		vector<int> tiles(num_tiles);
+		std::iota(tiles.begin(), tiles.end(), 0);
+		std::for_each(std::execution::par, tiles.begin(), tiles.end(), run_tile);
+#endif
+		break;
+	}
+	default: {
+		// split tiles evenly between worker threads in contiguous blocks
+		vector<std::thread> threads;
+		unsigned int tiles_per_thread = num_tiles / worker_threads + 1;
+		for (unsigned int j = 0; j < worker_threads; j++) {
+			threads.emplace_back([&, j] {
+				for (int i = j * tiles_per_thread; i < min<int>(num_tiles, (j + 1) * tiles_per_thread); i++) {
+					run_tile(i);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		break;
+	}
+	}
+	return true;
+}
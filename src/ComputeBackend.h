@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <functional>
+
+namespace GeneticSimulation
+{
+	// ways of parallelizing precomputation across CPU cores
+	enum compute_backend {
+		// std::threads each given a contiguous block of tiles
+		threads_backend,
+		// OpenMP loop over tiles
+		openmp_backend,
+		// C++17 parallel algorithm over tiles
+		parallel_backend,
+		num_compute_backends
+	};
+
+	// get name of a compute backend
+	const char* get_compute_backend_name(compute_backend b);
+
+	// get compute backend from its name (threads backend if not recognized)
+	compute_backend parse_compute_backend(const std::string& name);
+
+	// get whether a compute backend was enabled when building
+	bool get_compute_backend_available(compute_backend b);
+
+	// call a function with the y and t ranges of each tile covering height by width cells, in parallel
+	// using the given backend (with the given number of worker threads unless the backend chooses
+	// itself), returning whether the backend was available
+	bool parallel_for_tiles(compute_backend backend, unsigned int worker_threads, unsigned int height,
+		unsigned int width, unsigned int tile_height, unsigned int tile_width,
+		const std::function<void(unsigned int start_y, unsigned int end_y, unsigned int start_t, unsigned int end_t)>& f);
+}
@@ -53,7 +53,12 @@ void GeneticSimulation::Config::set_up_options_description(po::options_descripti
 			"Select which task to run: \n"
 			"0 = run simulation\n"
 			"1 = benchmark simulation\n"
-			"2 = benchmark temperature computation")
+			"2 = benchmark temperature computation\n"
+			"3 = check steady-state loop for heap allocations (headless)\n"
+			"4 = estimate memory footprint from config\n"
+			"5 = validate statistics against single-threaded reference (headless)\n"
+			"6 = play back a recorded replay (decode and time every frame if headless)\n"
+			"7 = run an ensemble of seeds concurrently on a bounded pool of workers sharing one planet (headless)")
 		("config_file,i", po::value<string>(), "Set path to config file")
 		("simulation_threads,s", po::value<unsigned int>(), "Set number of simulation threads")
 #ifdef GPU_SUPPORT
@@ -63,7 +68,22 @@ void GeneticSimulation::Config::set_up_options_description(po::options_descripti
 			"Set number of threads to use when precomputing temperatures on CPU")
 		("benchmark_timesteps,t", po::value<unsigned int>(), "Set number of timesteps in simulation benchmark period")
 		("planet_benchmark_samples,p", po::value<unsigned int>(),
-			"Set number of samples when benchmarking temperature computation");
+			"Set number of samples when benchmarking temperature computation")
+		("temperature_storage", po::value<string>(), "Set how to store temperatures: full, quantized, factored, sampled or windowed")
+		("temperature_shared_memory", po::value<bool>(),
+			"Set whether to share full or quantized temperatures with other processes through shared memory")
+		("headless", po::value<bool>(), "Set whether to run without a window")
+		("work_report,w", po::value<bool>(), "Set whether to report per-thread work counters and load imbalance")
+		("memory_report", po::value<bool>(), "Set whether to report estimated and measured memory footprint")
+		("metrics_port", po::value<unsigned int>(), "Set port to serve metrics on (0 = disabled)")
+		("validation_seeds", po::value<unsigned int>(), "Set number of seeds to run when validating against reference")
+		("ensemble_seeds", po::value<unsigned int>(), "Set number of seeds to run in an ensemble")
+		("restore", po::value<string>(), "Set path of checkpoint to restore simulation state from at startup")
+		("telemetry", po::value<string>(), "Set path of file to write population telemetry to (empty = disabled)")
+		("record", po::value<string>(), "Set path of file to record a replay to (empty = disabled)")
+		("replay", po::value<string>(), "Set path of replay file to play back in run mode 6")
+		("frames", po::value<string>(), "Set path of PNG files to render frames to (empty = disabled)")
+		("lineage", po::value<string>(), "Set path of file to log births, deaths and gene transfers to (empty = disabled)");
 }
 
 // parse program command line and store in variables map
@@ -151,10 +171,20 @@ void GeneticSimulation::Config::parse_config_file(const std::string& config_file
 #endif
 	precompute_temperatures_cpu_threads = get_numerical_option<unsigned int>(config_pt,
 		"Compute.precompute_temperatures_cpu_threads", 0, 256, 4);
+	precompute_temperatures_vectorized = get_option<bool>(config_pt, "Compute.precompute_temperatures_vectorized", true);
+	precompute_temperatures_backend = parse_compute_backend(
+		get_option<string>(config_pt, "Compute.precompute_temperatures_backend", "threads"));
 	simulation_benchmark_timesteps = get_numerical_option<unsigned int>(config_pt, 
 		"Compute.simulation_benchmark_timesteps", 1u, 1e6, 30000);
 	planet_benchmark_samples = get_numerical_option<unsigned int>(config_pt, 
 		"Compute.planet_benchmark_samples", 1, 1e3, 50);
+	allocation_check_warmup_timesteps = get_numerical_option<unsigned int>(config_pt,
+		"Compute.allocation_check_warmup_timesteps", 0, 1e6, 1000);
+	allocation_check_timesteps = get_numerical_option<unsigned int>(config_pt,
+		"Compute.allocation_check_timesteps", 1, 1e6, 5000);
+	headless = get_option<bool>(config_pt, "Compute.headless", false);
+	work_report = get_option<bool>(config_pt, "Compute.work_report", false);
+	memory_report = get_option<bool>(config_pt, "Compute.memory_report", false);
 	random_seed_factor = get_numerical_option<int>(config_pt, "Compute.random_seed_factor", -1000000, 1000000, 1);
 	results_path = get_option<std::string>(config_pt, "Compute.results_path", "./");
 
@@ -187,6 +217,14 @@ void GeneticSimulation::Config::parse_config_file(const std::string& config_file
 	atmosphere_optical_thickness = get_numerical_option<double>(config_pt, "Planet.atmosphere_optical_thickness", 0, 10, 1.3);
 	temperature_moderation_factor = get_numerical_option<double>(config_pt, "Planet.temperature_moderation_factor", 1, 10, 4.0);
 	temperature_moderation_bias = get_numerical_option<double>(config_pt, "Planet.temperature_moderation_bias", 0, 1, 0.8);
+	planet_temperature_storage = parse_temperature_storage(get_option<string>(config_pt, "Planet.temperature_storage", "full"));
+	planet_tilt_samples = get_numerical_option<unsigned int>(config_pt, "Planet.tilt_samples", 2, 65536, 2048);
+	planet_temperature_window = get_numerical_option<unsigned int>(config_pt, "Planet.temperature_window", 4, 1e5, 256);
+	planet_temperature_stride = get_numerical_option<unsigned int>(config_pt, "Planet.temperature_stride", 1, 1e6, 100);
+	planet_temperature_interpolation = parse_temperature_interpolation(
+		get_option<string>(config_pt, "Planet.temperature_interpolation", "cubic"));
+	planet_temperature_cache_path = get_option<string>(config_pt, "Planet.temperature_cache_path", "");
+	planet_temperature_shared_memory = get_option<bool>(config_pt, "Planet.temperature_shared_memory", false);
 
 	// set food options
 	food_pool_size = get_numerical_option<unsigned int>(config_pt, "Food.pool_size", 1, 8192, 148);
@@ -223,6 +261,60 @@ void GeneticSimulation::Config::parse_config_file(const std::string& config_file
 	behaviour_net_mutation_sigma = get_numerical_option<float>(config_pt, "Population.behaviour_net_mutation_sigma", 0, 10, 0.2f);
 	trait_genes_mutation_prob = get_numerical_option<float>(config_pt, "Population.trait_genes_mutation_prob", 0, 1, 0.1f);
 	trait_genes_mutation_sigma = get_numerical_option<float>(config_pt, "Population.trait_genes_mutation_sigma", 0, 2, 0.01f);
+
+	// set metrics options
+	metrics_port = get_numerical_option<unsigned int>(config_pt, "Metrics.port", 0, 65535, 0);
+	metrics_address = get_option<string>(config_pt, "Metrics.address", "127.0.0.1");
+
+	// set validation options
+	validation_seeds = get_numerical_option<unsigned int>(config_pt, "Validation.seeds", 2, 1000, 20);
+	validation_timesteps = get_numerical_option<unsigned int>(config_pt, "Validation.timesteps", 1, 1e7, 20000);
+	validation_sample_interval = get_numerical_option<unsigned int>(config_pt, "Validation.sample_interval",
+		1, validation_timesteps, 1000);
+	validation_significance = get_numerical_option<double>(config_pt, "Validation.significance", 1e-6, 0.5, 0.01);
+
+	// set checkpoint options
+	checkpoint_path = get_option<string>(config_pt, "Checkpoint.path", "checkpoint.bin");
+	checkpoint_interval = get_numerical_option<unsigned int>(config_pt, "Checkpoint.interval", 0, 1e9, 0);
+	checkpoint_keep = get_numerical_option<unsigned int>(config_pt, "Checkpoint.keep", 1, 1000, 3);
+	checkpoint_restore_path = get_option<string>(config_pt, "Checkpoint.restore", "");
+
+	// set telemetry options
+	telemetry_path = get_option<string>(config_pt, "Telemetry.path", "");
+	telemetry_interval = get_numerical_option<unsigned int>(config_pt, "Telemetry.interval", 1, 1e9, 1);
+	telemetry_queue_capacity = get_numerical_option<unsigned int>(config_pt, "Telemetry.queue_capacity", 2, 1 << 24, 4096);
+	telemetry_chunk_rows = get_numerical_option<unsigned int>(config_pt, "Telemetry.chunk_rows", 1, 1 << 24, 1024);
+
+	// set genome archive options
+	genome_archive_path = get_option<string>(config_pt, "Genomes.path", "");
+	genome_archive_interval = get_numerical_option<unsigned int>(config_pt, "Genomes.interval", 1, 1e9, 10000);
+	genome_archive_precision = parse_genome_precision(get_option<string>(config_pt, "Genomes.precision", "float16"));
+	genome_archive_compression = parse_genome_compression(get_option<string>(config_pt, "Genomes.compression", "zlib"));
+	genome_archive_block_genomes = get_numerical_option<unsigned int>(config_pt, "Genomes.block_genomes", 1, 1 << 24, 1024);
+
+	// set replay options
+	replay_record_path = get_option<string>(config_pt, "Replay.record_path", "");
+	replay_keyframe_interval = get_numerical_option<unsigned int>(config_pt, "Replay.keyframe_interval", 1, 1e9, 300);
+	replay_play_path = get_option<string>(config_pt, "Replay.play_path", "replay.bin");
+	replay_speed = get_numerical_option<float>(config_pt, "Replay.speed", 1.f / 64, 1024, 1);
+	replay_start = get_numerical_option<unsigned int>(config_pt, "Replay.start", 0, 4e9, 0);
+
+	// set frame rendering options
+	frames_path = get_option<string>(config_pt, "Frames.path", "");
+	frames_interval = get_numerical_option<unsigned int>(config_pt, "Frames.interval", 1, 1e9, 10);
+	frames_scale = get_numerical_option<float>(config_pt, "Frames.scale", 0.01f, 16, 1);
+	frames_snapshots = get_numerical_option<unsigned int>(config_pt, "Frames.snapshots", 1, 1024, 4);
+	frames_encode_threads = get_numerical_option<unsigned int>(config_pt, "Frames.encode_threads", 0, 1024, 0);
+
+	// set ensemble options
+	ensemble_seeds = get_numerical_option<unsigned int>(config_pt, "Ensemble.seeds", 1, 100000, 16);
+	ensemble_timesteps = get_numerical_option<unsigned int>(config_pt, "Ensemble.timesteps", 1, 1e9, 20000);
+	ensemble_workers = get_numerical_option<unsigned int>(config_pt, "Ensemble.workers", 0, 4096, 0);
+	ensemble_instance_threads = get_numerical_option<unsigned int>(config_pt, "Ensemble.instance_threads", 1, 256, 1);
+
+	// set lineage log options
+	lineage_path = get_option<string>(config_pt, "Lineage.path", "");
+	lineage_ring_capacity = get_numerical_option<unsigned int>(config_pt, "Lineage.ring_capacity", 64, 1 << 24, 65536);
 }
 
 // parse command line options excluding config file
@@ -253,6 +345,62 @@ void GeneticSimulation::Config::parse_command_line_options(const po::variables_m
 	if (vm.count("planet_benchmark_samples")) {
 		planet_benchmark_samples = vm["planet_benchmark_samples"].as<unsigned int>();
 	}
+
+	if (vm.count("temperature_storage")) {
+		planet_temperature_storage = parse_temperature_storage(vm["temperature_storage"].as<string>());
+	}
+
+	if (vm.count("temperature_shared_memory")) {
+		planet_temperature_shared_memory = vm["temperature_shared_memory"].as<bool>();
+	}
+
+	if (vm.count("headless")) {
+		headless = vm["headless"].as<bool>();
+	}
+
+	if (vm.count("work_report")) {
+		work_report = vm["work_report"].as<bool>();
+	}
+
+	if (vm.count("memory_report")) {
+		memory_report = vm["memory_report"].as<bool>();
+	}
+
+	if (vm.count("metrics_port")) {
+		metrics_port = std::min(65535u, vm["metrics_port"].as<unsigned int>());
+	}
+
+	if (vm.count("validation_seeds")) {
+		validation_seeds = std::max(2u, vm["validation_seeds"].as<unsigned int>());
+	}
+
+	if (vm.count("ensemble_seeds")) {
+		ensemble_seeds = std::max(1u, vm["ensemble_seeds"].as<unsigned int>());
+	}
+
+	if (vm.count("restore")) {
+		checkpoint_restore_path = vm["restore"].as<string>();
+	}
+
+	if (vm.count("telemetry")) {
+		telemetry_path = vm["telemetry"].as<string>();
+	}
+
+	if (vm.count("record")) {
+		replay_record_path = vm["record"].as<string>();
+	}
+
+	if (vm.count("replay")) {
+		replay_play_path = vm["replay"].as<string>();
+	}
+
+	if (vm.count("frames")) {
+		frames_path = vm["frames"].as<string>();
+	}
+
+	if (vm.count("lineage")) {
+		lineage_path = vm["lineage"].as<string>();
+	}
 }
 
 // convert a 3-byte hex string into a 32-bit color value
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "helper/platform.h"
+#include "TemperatureStorage.h"
+#include "ComputeBackend.h"
+#include "GenomeArchiveFormat.h"
 #include <string>
 #include <iostream>
 #include <boost/property_tree/ptree.hpp>
@@ -26,8 +29,15 @@ namespace GeneticSimulation
 		bool precompute_temperatures_gpu;
 #endif
 		unsigned int precompute_temperatures_cpu_threads;
+		bool precompute_temperatures_vectorized;
+		compute_backend precompute_temperatures_backend;
 		unsigned int simulation_benchmark_timesteps;
 		unsigned int planet_benchmark_samples;
+		unsigned int allocation_check_warmup_timesteps;
+		unsigned int allocation_check_timesteps;
+		bool headless;
+		bool work_report;
+		bool memory_report;
 		int random_seed_factor;
 		std::string results_path;
 
@@ -54,6 +64,13 @@ namespace GeneticSimulation
 		double atmosphere_optical_thickness;
 		double temperature_moderation_factor;
 		double temperature_moderation_bias;
+		temperature_storage planet_temperature_storage;
+		unsigned int planet_tilt_samples;
+		unsigned int planet_temperature_window;
+		unsigned int planet_temperature_stride;
+		temperature_interpolation planet_temperature_interpolation;
+		std::string planet_temperature_cache_path;
+		bool planet_temperature_shared_memory;
 
 		// food pool options
 		unsigned int food_pool_size;
@@ -91,6 +108,59 @@ namespace GeneticSimulation
 		float trait_genes_mutation_prob;
 		float trait_genes_mutation_sigma;
 
+		// metrics options
+		unsigned int metrics_port;
+		std::string metrics_address;
+
+		// validation options
+		unsigned int validation_seeds;
+		unsigned int validation_timesteps;
+		unsigned int validation_sample_interval;
+		double validation_significance;
+
+		// checkpoint options
+		std::string checkpoint_path;
+		unsigned int checkpoint_interval;
+		unsigned int checkpoint_keep;
+		std::string checkpoint_restore_path;
+
+		// telemetry options
+		std::string telemetry_path;
+		unsigned int telemetry_interval;
+		unsigned int telemetry_queue_capacity;
+		unsigned int telemetry_chunk_rows;
+
+		// genome archive options
+		std::string genome_archive_path;
+		unsigned int genome_archive_interval;
+		genome_precision genome_archive_precision;
+		genome_compression genome_archive_compression;
+		unsigned int genome_archive_block_genomes;
+
+		// replay options
+		std::string replay_record_path;
+		unsigned int replay_keyframe_interval;
+		std::string replay_play_path;
+		float replay_speed;
+		unsigned int replay_start;
+
+		// frame rendering options
+		std::string frames_path;
+		unsigned int frames_interval;
+		float frames_scale;
+		unsigned int frames_snapshots;
+		unsigned int frames_encode_threads;
+
+		// ensemble options
+		unsigned int ensemble_seeds;
+		unsigned int ensemble_timesteps;
+		unsigned int ensemble_workers;
+		unsigned int ensemble_instance_threads;
+
+		// lineage log options
+		std::string lineage_path;
+		unsigned int lineage_ring_capacity;
+
 	private:
 
 		// set up command line options description
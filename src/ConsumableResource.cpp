@@ -7,8 +7,8 @@ GeneticSimulation::ConsumableResource::ConsumableResource(sf::Color color, Simul
 	SimulationObject(area), value(0)
 {
 	set_sprite_color(color);
-	set_sprite_outline_thickness(-1.f);
-	set_sprite_outline_color(sf::Color(138, 31, 89, 200));
+	set_sprite_outline_thickness(get_outline_thickness());
+	set_sprite_outline_color(get_outline_color());
 }
 
 // initialize the item with a value and a position
@@ -29,4 +29,36 @@ unsigned int GeneticSimulation::ConsumableResource::consume()
 {
 	set_exists(false);
 	return value;
-}
\ No newline at end of file
+}
+
+// get energy value of resource
+unsigned int GeneticSimulation::ConsumableResource::get_value() const
+{
+	return value;
+}
+
+// write object state and value to a checkpoint
+void GeneticSimulation::ConsumableResource::write_checkpoint(CheckpointWriter& writer) const
+{
+	SimulationObject::write_checkpoint(writer);
+	writer.write(value);
+}
+
+// read object state and value from a checkpoint
+void GeneticSimulation::ConsumableResource::read_checkpoint(CheckpointReader& reader)
+{
+	SimulationObject::read_checkpoint(reader);
+	reader.read(value);
+}
+
+// get outline color of sprite, shared by all resources
+sf::Color GeneticSimulation::ConsumableResource::get_outline_color()
+{
+	return sf::Color(138, 31, 89, 200);
+}
+
+// get outline thickness of sprite (negative to draw inwards)
+float GeneticSimulation::ConsumableResource::get_outline_thickness()
+{
+	return -1.f;
+}
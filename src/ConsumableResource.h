@@ -22,6 +22,21 @@ namespace GeneticSimulation
 		// consume the resource's energy
 		unsigned int consume();
 
+		// get energy value of resource
+		unsigned int get_value() const;
+
+		// write object state and value to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read object state and value from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
+		// get outline color of sprite, shared by all resources
+		static sf::Color get_outline_color();
+
+		// get outline thickness of sprite (negative to draw inwards)
+		static float get_outline_thickness();
+
 	private:
 
 		// value of resource
@@ -49,6 +49,12 @@ unsigned int GeneticSimulation::ConsumableResourcePool::consume_and_reset_item(u
 	return value;
 }
 
+// get color of items
+sf::Color GeneticSimulation::ConsumableResourcePool::get_item_color() const
+{
+	return item_color;
+}
+
 // reset an item
 void GeneticSimulation::ConsumableResourcePool::reset_item(unsigned int i, default_random_engine& rng)
 {
@@ -22,6 +22,9 @@ namespace GeneticSimulation
 		// consume an item and reset its position and value
 		unsigned int consume_and_reset_item(unsigned int i, std::default_random_engine& rng);
 
+		// get color of items
+		sf::Color get_item_color() const;
+
 	private:
 
 		// reset an item
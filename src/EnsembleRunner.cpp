@@ -0,0 +1,198 @@
+#include "EnsembleRunner.h"
+#include "Simulation.h"
+#include "helper/statistics.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <boost/thread/thread.hpp>
+#include <boost/filesystem.hpp>
+
+using std::vector;
+using std::string;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::fixed;
+using std::setprecision;
+using std::setw;
+using std::max;
+using std::min;
+using std::memory_order_relaxed;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+using namespace GeneticSimulation;
+
+// constructor which takes the configuration shared by all seeds
+GeneticSimulation::EnsembleRunner::EnsembleRunner(const Config& config) :
+	config(config), planet(std::make_shared<Planet>()) {}
+
+// run all seeds, report results per seed and return exit status
+int GeneticSimulation::EnsembleRunner::run()
+{
+	// number of seeds to run at once, each with its own simulation threads
+	unsigned int instance_threads = max(1u, config.ensemble_instance_threads);
+	unsigned int workers = config.ensemble_workers != 0 ? config.ensemble_workers :
+		max(1u, boost::thread::hardware_concurrency() / instance_threads);
+	workers = min(workers, config.ensemble_seeds);
+
+	// precompute planet once for every seed
+	if (config.planet_temperature_storage == windowed_storage) {
+		cerr << "Windowed temperature storage follows a single simulation, so the ensemble shares full storage instead\n";
+	}
+	auto start = steady_clock::now();
+	auto planet_config = make_run_config(config.random_seed_factor);
+	planet->precompute_temperatures(planet_config);
+	double planet_seconds = duration<double>(steady_clock::now() - start).count();
+	MemoryFootprint planet_footprint;
+	planet->add_memory_usage(planet_footprint);
+
+	cout << "Running ensemble of " << config.ensemble_seeds << " seeds of " << config.ensemble_timesteps
+		<< " timesteps on " << workers << " workers with " << instance_threads << " simulation threads each, sharing "
+		<< fixed << setprecision(2) << planet_footprint.get_total() / (1024.0 * 1024.0)
+		<< " MiB of planet temperatures precomputed in " << planet_seconds << " s\n" << std::defaultfloat;
+
+	// run seeds on worker threads, each taking the next seed not yet started until none are left
+	vector<EnsembleResult> results(config.ensemble_seeds);
+	std::atomic<unsigned int> next_seed(0);
+	std::mutex output_mutex;
+	unsigned int finished = 0;
+	start = steady_clock::now();
+	vector<std::thread> worker_threads;
+	for (unsigned int w = 0; w < workers; w++) {
+		worker_threads.emplace_back([&] {
+			for (auto s = next_seed++; s < config.ensemble_seeds; s = next_seed++) {
+				results[s] = run_seed(make_run_config(config.random_seed_factor + static_cast<int>(s)));
+				std::lock_guard<std::mutex> lock(output_mutex);
+				finished++;
+				cout << "Seed " << finished << "/" << config.ensemble_seeds << " finished: " << results[s].seed
+					<< " in " << fixed << setprecision(2) << results[s].seconds << " s\n" << std::defaultfloat;
+			}
+		});
+	}
+	for (auto& t : worker_threads) {
+		t.join();
+	}
+	double seconds = duration<double>(steady_clock::now() - start).count();
+
+	// report results per seed and across seeds
+	cout << setw(12) << "seed" << setw(10) << "seconds" << setw(8) << "alive" << setw(14) << "mean fitness"
+		<< setw(10) << "births" << setw(10) << "deaths" << setw(12) << "transfers" << setw(10) << "founders"
+		<< setw(16) << "ancestor born\n";
+	vector<double> alive, fitness;
+	double seed_seconds = 0;
+	for (auto& r : results) {
+		cout << setw(12) << r.seed << fixed << setprecision(2) << setw(10) << r.seconds << setw(8) << r.alive
+			<< setprecision(4) << setw(14) << r.mean_fitness << std::defaultfloat << setw(10) << r.births
+			<< setw(10) << r.deaths << setw(12) << r.gene_transfers << setw(10) << r.founder_lineages << setw(15);
+		if (r.common_ancestor_timestep >= 0) cout << r.common_ancestor_timestep;
+		else cout << "-";
+		cout << "\n";
+		alive.push_back(r.alive);
+		fitness.push_back(r.mean_fitness);
+		seed_seconds += r.seconds;
+	}
+	cout << "Ran " << config.ensemble_seeds << " seeds in " << fixed << setprecision(2) << seconds << " s ("
+		<< config.ensemble_seeds * static_cast<double>(config.ensemble_timesteps) / max(seconds, 1e-9)
+		<< " timesteps/s in total, " << seed_seconds / max(seconds, 1e-9) << " seeds running on average), "
+		<< "final population " << sample_mean(alive) << " +/- " << sample_standard_deviation(alive)
+		<< ", mean fitness " << setprecision(4) << sample_mean(fitness) << " +/- "
+		<< sample_standard_deviation(fitness) << "\n" << std::defaultfloat;
+
+	write_results(results, "ensemble_results.csv", config.results_path);
+	return 0;
+}
+
+// create configuration for the run of a seed
+Config GeneticSimulation::EnsembleRunner::make_run_config(int seed) const
+{
+	Config run_config = config;
+	run_config.run_mode = 0;
+	run_config.random_seed_factor = seed;
+	run_config.headless = true;
+	run_config.simulation_threads = max(1u, config.ensemble_instance_threads);
+	run_config.work_report = false;
+	run_config.memory_report = false;
+	run_config.metrics_port = 0;
+	run_config.checkpoint_interval = 0;
+	run_config.checkpoint_restore_path.clear();
+	run_config.telemetry_path.clear();
+	run_config.genome_archive_path.clear();
+	run_config.replay_record_path.clear();
+	run_config.frames_path.clear();
+	run_config.lineage_path.clear();
+	// windowed temperatures are computed as one simulation advances, so cannot be shared
+	if (run_config.planet_temperature_storage == windowed_storage) {
+		run_config.planet_temperature_storage = full_storage;
+	}
+	return run_config;
+}
+
+// run simulation of a seed with the shared planet and record its final state
+EnsembleRunner::EnsembleResult GeneticSimulation::EnsembleRunner::run_seed(const Config& run_config) const
+{
+	EnsembleResult result;
+	result.seed = run_config.random_seed_factor;
+	auto start = steady_clock::now();
+	Simulation simulation(run_config, planet);
+	simulation.init();
+	simulation.run_headless(config.ensemble_timesteps, [&](unsigned int t, const Population& population) {
+		if (t != config.ensemble_timesteps) return;
+		auto summary = population.summarize();
+		auto& counters = population.get_counters();
+		auto phylogeny = population.get_phylogeny().summarize();
+		result.alive = summary.alive;
+		result.mean_fitness = summary.mean_fitness;
+		result.births = counters.births.load(memory_order_relaxed);
+		result.deaths = counters.deaths.load(memory_order_relaxed);
+		result.gene_transfers = counters.gene_transfers.load(memory_order_relaxed);
+		result.founder_lineages = phylogeny.founder_lineages;
+		if (phylogeny.has_common_ancestor) result.common_ancestor_timestep = phylogeny.common_ancestor.birth_timestep;
+	});
+	result.seconds = duration<double>(steady_clock::now() - start).count();
+	return result;
+}
+
+// write results of every seed to file
+void GeneticSimulation::EnsembleRunner::write_results(const vector<EnsembleResult>& results,
+	const string& filename, const string& path) const
+{
+	// alias for boost filesystem namespace
+	namespace fs = boost::filesystem;
+
+	// generate path for results file
+	fs::path results_file_path(path);
+	results_file_path /= filename;
+
+	// output name of results file
+	cout << "Writing ensemble results to " << results_file_path.string() << "\n";
+
+	// attempt to write results
+	try {
+		// open file
+		fs::ofstream results_file(results_file_path, ios::trunc);
+		// print error and return if opening file failed
+		if (!results_file) {
+			cerr << "Writing ensemble results file failed: Check that the path exists and may be written to\n";
+			return;
+		}
+		// write header and a row per seed
+		results_file << "seed,timesteps,seconds,alive,mean_fitness,births,deaths,gene_transfers,"
+			"founder_lineages,common_ancestor_timestep\n";
+		for (auto& r : results) {
+			results_file << r.seed << "," << config.ensemble_timesteps << "," << r.seconds << "," << r.alive << ","
+				<< r.mean_fitness << "," << r.births << "," << r.deaths << "," << r.gene_transfers << ","
+				<< r.founder_lineages << "," << r.common_ancestor_timestep << "\n";
+		}
+		// close file
+		results_file.close();
+	}
+	catch (const fs::filesystem_error& e) {
+		// if writing results fails, log error
+		cerr << "Writing ensemble results file failed: " << e.what() << "\n";
+	}
+}
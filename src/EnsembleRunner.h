@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Config.h"
+#include "Planet.h"
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace GeneticSimulation
+{
+	// Runs many seeds of one configuration headless in a single process, with every simulation reading
+	// one planet precomputed up front, and a fixed pool of worker threads each taking the next seed as
+	// soon as it finishes one so that the processors stay busy without being oversubscribed
+	class EnsembleRunner
+	{
+	public:
+
+		// constructor which takes the configuration shared by all seeds
+		explicit EnsembleRunner(const Config& config);
+
+		// run all seeds, report results per seed and return exit status
+		int run();
+
+	private:
+
+		// final state and speed of the run of one seed
+		struct EnsembleResult
+		{
+			int seed = 0;
+			double seconds = 0;
+			unsigned int alive = 0;
+			double mean_fitness = 0;
+			unsigned long long births = 0;
+			unsigned long long deaths = 0;
+			unsigned long long gene_transfers = 0;
+			unsigned int founder_lineages = 0;
+			// birth timestep of the population's common ancestor (-1 if there is none)
+			long long common_ancestor_timestep = -1;
+		};
+
+		// create configuration for the run of a seed
+		Config make_run_config(int seed) const;
+
+		// run simulation of a seed with the shared planet and record its final state
+		EnsembleResult run_seed(const Config& run_config) const;
+
+		// write results of every seed to file
+		void write_results(const std::vector<EnsembleResult>& results, const std::string& filename,
+			const std::string& path) const;
+
+		// reference to configuration shared by all seeds
+		const Config& config;
+		// planet precomputed once and read by every simulation
+		std::shared_ptr<Planet> planet;
+	};
+}
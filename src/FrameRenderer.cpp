@@ -0,0 +1,269 @@
+#include "FrameRenderer.h"
+#include "Organism.h"
+#include "ConsumableResource.h"
+#include "helper/Checkpoint.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::cerr;
+using std::max;
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+using std::chrono::duration_cast;
+
+using namespace GeneticSimulation;
+
+// constructor which takes the path image file names are based on, the area size, pixels per
+// cell, background and resource item colors, gene transfer effect length, number of snapshots
+// which may be waiting to be rendered and number of encoding threads (0 = number of hardware processors)
+GeneticSimulation::FrameRenderer::FrameRenderer(const string& path, sf::Vector2u area_size, float scale,
+	sf::Color background_color, sf::Color food_color, sf::Color water_color, float transfer_effect_len,
+	unsigned int snapshots, unsigned int encode_threads) :
+	path(path), area_size(area_size),
+	frame_size(max(1u, static_cast<unsigned int>(std::lround(area_size.x * scale))),
+		max(1u, static_cast<unsigned int>(std::lround(area_size.y * scale)))),
+	scale(scale), background_color(background_color), food_color(food_color), water_color(water_color),
+	transfer_effect_len(transfer_effect_len),
+	snapshots(max(1u, snapshots)), busy(0), encoded(0), skipped(0), failed(0), render_us(0), encode_us(0),
+	stop(false), rendering_done(false)
+{
+	// create directory for frames so that encoding threads only write files
+	try {
+		auto directory = boost::filesystem::path(path).parent_path();
+		if (!directory.empty()) boost::filesystem::create_directories(directory);
+	}
+	catch (const boost::filesystem::filesystem_error& e) {
+		cerr << "Creating directory for frames failed: " << e.what() << "\n";
+	}
+
+	// start encoding threads before the rendering thread, which limits frames waiting by their number
+	if (encode_threads == 0) encode_threads = max(1u, std::thread::hardware_concurrency());
+	for (unsigned int i = 0; i < encode_threads; i++) {
+		this->encode_threads.emplace_back([this] { encode(); });
+	}
+	render_thread = std::thread([this] { render(); });
+}
+
+// destructor which renders and encodes any remaining snapshots and stops the threads
+GeneticSimulation::FrameRenderer::~FrameRenderer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		stop = true;
+	}
+	snapshot_submitted.notify_one();
+	render_thread.join();
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		rendering_done = true;
+	}
+	frame_submitted.notify_all();
+	for (auto& t : encode_threads) {
+		t.join();
+	}
+
+	auto frames_made = max(1u, encoded);
+	cout << "Rendered " << encoded << " frames of " << frame_size.x << "x" << frame_size.y << " pixels to " << path
+		<< " (" << skipped << " skipped as rendering could not keep up, " << failed << " failed, mean "
+		<< render_us / frames_made / 1000.0 << " ms to render and " << encode_us / frames_made / 1000.0
+		<< " ms to encode)\n";
+}
+
+// copy drawing state of organisms and resource items to be rendered in the background (should
+// only be called while no simulation thread is running), returning false if every snapshot is
+// still waiting to be rendered
+bool GeneticSimulation::FrameRenderer::snapshot(unsigned int timestep, const Population& population,
+	const ConsumableResourcePool& food, const ConsumableResourcePool& water)
+{
+	// claim a free snapshot
+	Snapshot* s = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		for (auto& candidate : snapshots) {
+			if (candidate.state == Snapshot::free_snapshot) {
+				s = &candidate;
+				s->state = Snapshot::filling_snapshot;
+				break;
+			}
+		}
+		if (!s) {
+			skipped++;
+			cerr << "Skipping frame at timestep " << timestep << ": previous frames are still being rendered\n";
+			return false;
+		}
+	}
+
+	// copy existing objects (the buffers only grow until they fit the whole population and pools)
+	s->timestep = timestep;
+	s->organisms.clear();
+	for (unsigned int i = 0; i < population.get_max_size(); i++) {
+		auto& o = population[i];
+		if (!o.get_exists()) continue;
+		s->organisms.push_back({ o.get_position(), o.get_size(), o.get_health(),
+			o.get_transfer_effect_progress(transfer_effect_len) });
+	}
+	for (auto pool : { std::make_pair(&food, &s->food), std::make_pair(&water, &s->water) }) {
+		pool.second->clear();
+		for (unsigned int i = 0; i < pool.first->get_max_size(); i++) {
+			auto& o = (*pool.first)[i];
+			if (o.get_exists()) pool.second->push_back({ o.get_position(), o.get_size(), 0, 0 });
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		s->state = Snapshot::queued_snapshot;
+		busy++;
+	}
+	snapshot_submitted.notify_one();
+	return true;
+}
+
+// wait until all snapshots have been rendered and encoded
+void GeneticSimulation::FrameRenderer::wait_until_idle()
+{
+	std::unique_lock<std::mutex> lock(mx);
+	frame_done.wait(lock, [&] { return busy == 0; });
+}
+
+// render queued snapshots in timestep order until stopped
+void GeneticSimulation::FrameRenderer::render()
+{
+	// the render texture is created on this thread, so that its OpenGL context is active here
+	sf::RenderTexture texture;
+	bool created = texture.create(frame_size.x, frame_size.y);
+	if (!created) {
+		cerr << "Creating " << frame_size.x << "x" << frame_size.y << " render texture for frames failed\n";
+	}
+	// limit frames waiting to be encoded, so that rendering does not outpace encoding
+	auto max_frames = encode_threads.size() * 2;
+
+	while (true) {
+		// wait for the earliest queued snapshot, or return once stopped and there are none left
+		Snapshot* s = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mx);
+			snapshot_submitted.wait(lock, [&] {
+				return stop || std::any_of(snapshots.begin(), snapshots.end(),
+					[](const Snapshot& c) { return c.state == Snapshot::queued_snapshot; });
+			});
+			for (auto& candidate : snapshots) {
+				if (candidate.state == Snapshot::queued_snapshot && (!s || candidate.timestep < s->timestep)) {
+					s = &candidate;
+				}
+			}
+			if (!s) return;
+			s->state = Snapshot::rendering_snapshot;
+		}
+
+		// draw snapshot and copy it from the texture into an image
+		auto start = steady_clock::now();
+		sf::Image image;
+		if (created) {
+			draw(texture, *s);
+			image = texture.getTexture().copyToImage();
+		}
+		auto timestep = s->timestep;
+		auto elapsed = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+		// release snapshot and queue frame for encoding once there is room
+		{
+			std::unique_lock<std::mutex> lock(mx);
+			s->state = Snapshot::free_snapshot;
+			render_us += elapsed;
+			if (!created) {
+				failed++;
+				busy--;
+				frame_done.notify_all();
+				continue;
+			}
+			frame_done.wait(lock, [&] { return frames.size() < max_frames; });
+			frames.emplace_back(timestep, std::move(image));
+		}
+		frame_submitted.notify_one();
+	}
+}
+
+// encode rendered frames until rendering has finished
+void GeneticSimulation::FrameRenderer::encode()
+{
+	while (true) {
+		// wait for a frame, or return once rendering has finished and there are none left
+		std::pair<unsigned int, sf::Image> frame;
+		{
+			std::unique_lock<std::mutex> lock(mx);
+			frame_submitted.wait(lock, [&] { return rendering_done || !frames.empty(); });
+			if (frames.empty()) return;
+			frame = std::move(frames.front());
+			frames.pop_front();
+		}
+		frame_done.notify_all();
+
+		// encode frame into an image file named with its timestep
+		auto start = steady_clock::now();
+		auto frame_path = get_timestep_path(path, frame.first);
+		bool written = frame.second.saveToFile(frame_path);
+		auto elapsed = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+		{
+			std::lock_guard<std::mutex> lock(mx);
+			encode_us += elapsed;
+			if (written) {
+				encoded++;
+			}
+			else {
+				failed++;
+				cerr << "Writing frame " << frame_path << " failed\n";
+			}
+			busy--;
+		}
+		frame_done.notify_all();
+	}
+}
+
+// draw a snapshot into the render texture
+void GeneticSimulation::FrameRenderer::draw(sf::RenderTexture& texture, const Snapshot& snapshot)
+{
+	// draw shape at position, and also at the opposite edges if it may be wrapping around as in the window
+	auto draw_shape = [&](sf::CircleShape& shape, const FrameObject& o, bool wrap) {
+		shape.setRadius(o.size);
+		shape.setOrigin(o.size, o.size);
+		shape.setScale(scale, scale);
+		shape.setPosition(o.position.x * scale, o.position.y * scale);
+		texture.draw(shape);
+		sf::Vector2f second_position;
+		if (wrap && SimulationObject::get_wrapped_position(o.position, o.size, area_size, second_position)) {
+			shape.setPosition(second_position.x * scale, second_position.y * scale);
+			texture.draw(shape);
+		}
+	};
+
+	texture.clear(background_color);
+
+	// draw water and food below organisms as in the window
+	sf::CircleShape resource_shape;
+	resource_shape.setOutlineThickness(ConsumableResource::get_outline_thickness());
+	resource_shape.setOutlineColor(ConsumableResource::get_outline_color());
+	for (auto items : { std::make_pair(&snapshot.water, water_color), std::make_pair(&snapshot.food, food_color) }) {
+		resource_shape.setFillColor(items.second);
+		for (auto& o : *items.first) {
+			draw_shape(resource_shape, o, false);
+		}
+	}
+
+	sf::CircleShape organism_shape;
+	organism_shape.setOutlineThickness(Organism::get_outline_thickness());
+	for (auto& o : snapshot.organisms) {
+		organism_shape.setFillColor(Organism::calculate_color(o.health));
+		organism_shape.setOutlineColor(Organism::calculate_outline_color(o.effect_progress));
+		draw_shape(organism_shape, o, true);
+	}
+
+	texture.display();
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Population.h"
+#include "ConsumableResourcePool.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <SFML/System.hpp>
+#include <SFML/Graphics.hpp>
+
+namespace GeneticSimulation
+{
+	// Renders frames of the whole simulation area offscreen, copying the drawing state of every
+	// object into a snapshot at the end of a timestep and leaving drawing into a render texture to
+	// a background thread and encoding each frame as a PNG image to a pool of worker threads
+	class FrameRenderer
+	{
+	public:
+
+		// constructor which takes the path image file names are based on, the area size, pixels per
+		// cell, background and resource item colors, gene transfer effect length, number of snapshots
+		// which may be waiting to be rendered and number of encoding threads (0 = number of hardware processors)
+		FrameRenderer(const std::string& path, sf::Vector2u area_size, float scale, sf::Color background_color,
+			sf::Color food_color, sf::Color water_color, float transfer_effect_len, unsigned int snapshots,
+			unsigned int encode_threads);
+
+		// destructor which renders and encodes any remaining snapshots and stops the threads
+		~FrameRenderer();
+
+		// copy drawing state of organisms and resource items to be rendered in the background (should
+		// only be called while no simulation thread is running), returning false if every snapshot is
+		// still waiting to be rendered
+		bool snapshot(unsigned int timestep, const Population& population,
+			const ConsumableResourcePool& food, const ConsumableResourcePool& water);
+
+		// wait until all snapshots have been rendered and encoded
+		void wait_until_idle();
+
+	private:
+
+		// drawing state of an existing object (health and gene transfer effect progress for organisms)
+		struct FrameObject
+		{
+			sf::Vector2f position;
+			float size;
+			float health;
+			float effect_progress;
+		};
+
+		// drawing state of organisms and resource items at a timestep
+		struct Snapshot
+		{
+			enum snapshot_state { free_snapshot, filling_snapshot, queued_snapshot, rendering_snapshot };
+			snapshot_state state = free_snapshot;
+			unsigned int timestep = 0;
+			std::vector<FrameObject> organisms;
+			std::vector<FrameObject> food;
+			std::vector<FrameObject> water;
+		};
+
+		// render queued snapshots in timestep order until stopped
+		void render();
+
+		// encode rendered frames until rendering has finished
+		void encode();
+
+		// draw a snapshot into the render texture
+		void draw(sf::RenderTexture& texture, const Snapshot& snapshot);
+
+		// path image file names are based on
+		const std::string path;
+		// area size in cells, and frame size in pixels
+		const sf::Vector2u area_size;
+		const sf::Vector2u frame_size;
+		// pixels per cell
+		const float scale;
+		// background and resource item colors
+		const sf::Color background_color;
+		const sf::Color food_color;
+		const sf::Color water_color;
+		// length of gene transfer graphical effect in timesteps
+		const float transfer_effect_len;
+		// snapshots being filled, waiting to be rendered or being rendered
+		std::vector<Snapshot> snapshots;
+		// rendered frames waiting to be encoded, with their timesteps
+		std::deque<std::pair<unsigned int, sf::Image>> frames;
+		// number of frames being rendered or encoded
+		unsigned int busy;
+		// number of frames encoded, snapshots skipped and frames which could not be rendered or written
+		unsigned int encoded;
+		unsigned int skipped;
+		unsigned int failed;
+		// total time spent rendering and encoding frames in microseconds
+		unsigned long long render_us;
+		unsigned long long encode_us;
+		// whether rendering thread should stop, and whether it has stopped
+		bool stop;
+		bool rendering_done;
+		// mutex and condition variables for submitting snapshots and frames and waiting for them
+		std::mutex mx;
+		std::condition_variable snapshot_submitted;
+		std::condition_variable frame_submitted;
+		std::condition_variable frame_done;
+		// background thread rendering snapshots, and worker threads encoding frames
+		std::thread render_thread;
+		std::vector<std::thread> encode_threads;
+	};
+}
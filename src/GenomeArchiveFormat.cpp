@@ -0,0 +1,58 @@
+#include "GenomeArchiveFormat.h"
+#include <iostream>
+
+static_assert(sizeof(GeneticSimulation::GenomeArchiveHeader) == 64, "genome archive header must be 64 bytes");
+
+// identifier and format version of genome archives
+const char GeneticSimulation::genome_archive_magic[8] = "GSGENOM";
+const uint32_t GeneticSimulation::genome_archive_version = 1;
+
+// get name of a genome precision
+const char* GeneticSimulation::get_genome_precision_name(genome_precision p)
+{
+	switch (p) {
+	case float32_genes: return "float32";
+	case float16_genes: return "float16";
+	case int8_genes: return "int8";
+	default: return "unknown";
+	}
+}
+
+// get genome precision from its name (float16 if not recognized)
+GeneticSimulation::genome_precision GeneticSimulation::parse_genome_precision(const std::string& name)
+{
+	for (unsigned int p = 0; p < num_genome_precisions; p++) {
+		if (name == get_genome_precision_name(static_cast<genome_precision>(p))) {
+			return static_cast<genome_precision>(p);
+		}
+	}
+	std::cerr << "Unknown genome precision: " << name << ", using float16\n";
+	return float16_genes;
+}
+
+// get name of a genome compression
+const char* GeneticSimulation::get_genome_compression_name(genome_compression c)
+{
+	switch (c) {
+	case no_compression: return "none";
+	case zlib_compression: return "zlib";
+	default: return "unknown";
+	}
+}
+
+// get genome compression from its name (none if not recognized or not enabled when building)
+GeneticSimulation::genome_compression GeneticSimulation::parse_genome_compression(const std::string& name)
+{
+	if (name == get_genome_compression_name(zlib_compression)) {
+#ifdef ZLIB_SUPPORT
+		return zlib_compression;
+#else
+		std::cerr << "Genome compression zlib was not enabled when building, using none\n";
+		return no_compression;
+#endif
+	}
+	if (name != get_genome_compression_name(no_compression)) {
+		std::cerr << "Unknown genome compression: " << name << ", using none\n";
+	}
+	return no_compression;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace GeneticSimulation
+{
+	// precisions genes may be stored at in a genome archive
+	enum genome_precision {
+		// 32-bit floats, unchanged
+		float32_genes,
+		// IEEE 754 half-precision floats
+		float16_genes,
+		// 8-bit signed integers times a float scale per gene per block
+		int8_genes,
+		num_genome_precisions
+	};
+
+	// ways of compressing blocks of a genome archive
+	enum genome_compression {
+		// blocks stored as is, so that genes can be read in place from a mapped file
+		no_compression,
+		// each block compressed with zlib
+		zlib_compression,
+		num_genome_compressions
+	};
+
+	/*
+		Genome archive file layout (all values little-endian):
+
+		header        GenomeArchiveHeader below (64 bytes)
+		organisms     uint32 population index of each genome, padded to a multiple of 8 bytes
+		directory     for each block, uint64 file offset, uint64 stored bytes and uint64 raw bytes
+		blocks        each starting at a multiple of 64 bytes, holding up to genomes_per_block
+		              consecutive genomes gene-major (every genome's first gene, then every genome's
+		              second gene and so on), preceded for int8 precision by a float scale per gene
+
+		Each genome is the weights of the three behaviour net layers in turn (each stored
+		input-major, with the layer shapes given by layer_sizes) followed by the trait genes.
+	*/
+	struct GenomeArchiveHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t precision;
+		uint32_t compression;
+		uint32_t timestep;
+		uint32_t genomes;
+		uint32_t genes_per_genome;
+		uint32_t trait_genes;
+		uint32_t layer_sizes[4];
+		uint32_t genomes_per_block;
+		uint32_t blocks;
+		uint32_t reserved;
+	};
+
+	// identifier and format version of genome archives
+	extern const char genome_archive_magic[8];
+	extern const uint32_t genome_archive_version;
+
+	// get name of a genome precision
+	const char* get_genome_precision_name(genome_precision p);
+
+	// get genome precision from its name (float16 if not recognized)
+	genome_precision parse_genome_precision(const std::string& name);
+
+	// get name of a genome compression
+	const char* get_genome_compression_name(genome_compression c);
+
+	// get genome compression from its name (none if not recognized or not enabled when building)
+	genome_compression parse_genome_compression(const std::string& name);
+}
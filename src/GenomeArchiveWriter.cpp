@@ -0,0 +1,328 @@
+#include "GenomeArchiveWriter.h"
+#include "helper/Checkpoint.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#ifdef ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+using std::string;
+using std::vector;
+using std::size_t;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+using std::chrono::duration_cast;
+
+using namespace GeneticSimulation;
+
+// alignment of blocks within archive, so that mapped blocks can be read in place with any element type
+static const size_t block_alignment = 64;
+
+// round a size up to a multiple of an alignment
+static size_t align_up(size_t size, size_t alignment)
+{
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+// convert a float to the nearest IEEE 754 half-precision float (ties to even)
+static uint16_t float_to_half(float value)
+{
+	uint32_t x;
+	std::memcpy(&x, &value, sizeof(x));
+	uint32_t sign = (x >> 16) & 0x8000;
+	int exponent = static_cast<int>((x >> 23) & 0xff) - 127 + 15;
+	uint32_t mantissa = x & 0x7fffff;
+	// infinity and NaN
+	if (((x >> 23) & 0xff) == 0xff) return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+	// overflow to infinity
+	if (exponent >= 31) return static_cast<uint16_t>(sign | 0x7c00);
+	// subnormal or underflow to zero
+	if (exponent <= 0) {
+		if (exponent < -10) return static_cast<uint16_t>(sign);
+		mantissa |= 0x800000;
+		uint32_t shift = 14 - exponent;
+		uint32_t half = mantissa >> shift;
+		uint32_t remainder = mantissa & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+		return static_cast<uint16_t>(sign | half);
+	}
+	// normal, where rounding may carry into the exponent
+	uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+	uint32_t remainder = mantissa & 0x1fff;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) half++;
+	return static_cast<uint16_t>(sign | half);
+}
+
+// convert an IEEE 754 half-precision float to a float
+static float half_to_float(uint16_t half)
+{
+	uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+	uint32_t exponent = (half >> 10) & 0x1f;
+	uint32_t mantissa = half & 0x3ff;
+	if (exponent == 0) {
+		float value = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign ? -value : value;
+	}
+	uint32_t x = exponent == 31 ? sign | 0x7f800000 | (mantissa << 13) :
+		sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	float value;
+	std::memcpy(&value, &x, sizeof(value));
+	return value;
+}
+
+// append raw bytes of a value to a buffer
+template<class T>
+static void append(vector<char>& buffer, const T& value)
+{
+	auto bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// constructor which takes the path archive file names are based on, the precision and
+// compression of genes, the number of genomes per block and the behaviour net layer sizes
+GeneticSimulation::GenomeArchiveWriter::GenomeArchiveWriter(const string& path, genome_precision precision,
+	genome_compression compression, unsigned int genomes_per_block, unsigned int nh1, unsigned int nh2) :
+	path(path), precision(precision), compression(compression), genomes_per_block(genomes_per_block),
+	layer_sizes{ 7, nh1, nh2, 2 }, has_pending(false), is_writing(false), stop(false)
+{
+	writer_thread = std::thread([this] { run(); });
+}
+
+// destructor which finishes writing any snapshot and stops the thread
+GeneticSimulation::GenomeArchiveWriter::~GenomeArchiveWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		stop = true;
+	}
+	snapshot_submitted.notify_one();
+	writer_thread.join();
+}
+
+// copy genes of every live organism to be archived in the background (should only be called
+// while no simulation thread is running), returning false if the previous snapshot has not yet
+// been picked up for writing
+bool GeneticSimulation::GenomeArchiveWriter::snapshot(unsigned int timestep, const Population& population)
+{
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		if (has_pending) {
+			cerr << "Skipping genome archive at timestep " << timestep << ": previous archives are still being written\n";
+			return false;
+		}
+
+		// copy genes of live organisms (the buffers only grow until they fit the whole population)
+		pending.timestep = timestep;
+		pending.genes_per_genome = static_cast<unsigned int>(population[0].get_genotype().get_num_genes());
+		pending.organisms.clear();
+		pending.genes.resize(static_cast<size_t>(population.get_max_size()) * pending.genes_per_genome);
+		auto out = pending.genes.data();
+		for (unsigned int i = 0; i < population.get_max_size(); i++) {
+			if (!population[i].get_exists()) continue;
+			pending.organisms.push_back(i);
+			out = population[i].get_genotype().copy_genes(out);
+		}
+		pending.genes.resize(out - pending.genes.data());
+		has_pending = true;
+	}
+	snapshot_submitted.notify_one();
+	return true;
+}
+
+// wait until all snapshots have been written
+void GeneticSimulation::GenomeArchiveWriter::wait_until_idle()
+{
+	std::unique_lock<std::mutex> lock(mx);
+	snapshot_written.wait(lock, [&] { return !has_pending && !is_writing; });
+}
+
+// write snapshots until stopped
+void GeneticSimulation::GenomeArchiveWriter::run()
+{
+	while (true) {
+		// wait for a snapshot and swap it into the buffer being written, so that the next
+		// snapshot can be taken meanwhile, or return once stopped and there are none left
+		{
+			std::unique_lock<std::mutex> lock(mx);
+			snapshot_submitted.wait(lock, [&] { return stop || has_pending; });
+			if (!has_pending) return;
+			std::swap(pending, writing);
+			has_pending = false;
+			is_writing = true;
+		}
+
+		write(writing);
+
+		{
+			std::lock_guard<std::mutex> lock(mx);
+			is_writing = false;
+		}
+		snapshot_written.notify_all();
+	}
+}
+
+// quantize and compress snapshot into blocks and write archive
+void GeneticSimulation::GenomeArchiveWriter::write(const Snapshot& snapshot)
+{
+	namespace fs = boost::filesystem;
+	auto start = steady_clock::now();
+	auto genomes = snapshot.organisms.size();
+	auto blocks = (genomes + genomes_per_block - 1) / genomes_per_block;
+
+	// encode and compress each block, recording its offset and sizes in the directory
+	size_t data_offset = align_up(sizeof(GenomeArchiveHeader) + align_up(genomes * sizeof(uint32_t), 8) +
+		blocks * 3 * sizeof(uint64_t), block_alignment);
+	vector<uint64_t> directory;
+	vector<char> data;
+	vector<char> raw;
+	size_t raw_bytes = 0;
+	double squared_error = 0, max_error = 0;
+	for (size_t b = 0; b < blocks; b++) {
+		auto first = b * genomes_per_block;
+		encode_block(snapshot, first, std::min<size_t>(genomes_per_block, genomes - first), raw, squared_error, max_error);
+		raw_bytes += raw.size();
+		data.resize(align_up(data.size(), block_alignment));
+		auto block_offset = data.size();
+#ifdef ZLIB_SUPPORT
+		if (compression == zlib_compression) {
+			uLongf stored_bytes = compressBound(static_cast<uLong>(raw.size()));
+			data.resize(block_offset + stored_bytes);
+			auto status = compress2(reinterpret_cast<Bytef*>(&data[block_offset]), &stored_bytes,
+				reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()), Z_DEFAULT_COMPRESSION);
+			// skip archive rather than write a block that cannot be inflated (nothing has been written yet)
+			if (status != Z_OK) {
+				cerr << "Compressing genome archive at timestep " << snapshot.timestep << " failed: "
+					<< zError(status) << "\n";
+				return;
+			}
+			data.resize(block_offset + stored_bytes);
+		}
+		else
+#endif
+		{
+			data.insert(data.end(), raw.begin(), raw.end());
+		}
+		directory.push_back(data_offset + block_offset);
+		directory.push_back(data.size() - block_offset);
+		directory.push_back(raw.size());
+	}
+
+	// header, organism indices and directory
+	GenomeArchiveHeader header = {};
+	std::memcpy(header.magic, genome_archive_magic, sizeof(header.magic));
+	header.version = genome_archive_version;
+	header.precision = precision;
+	header.compression = compression;
+	header.timestep = snapshot.timestep;
+	header.genomes = static_cast<uint32_t>(genomes);
+	header.genes_per_genome = snapshot.genes_per_genome;
+	header.trait_genes = 15;
+	std::copy(std::begin(layer_sizes), std::end(layer_sizes), header.layer_sizes);
+	header.genomes_per_block = genomes_per_block;
+	header.blocks = static_cast<uint32_t>(blocks);
+	vector<char> prefix;
+	append(prefix, header);
+	prefix.insert(prefix.end(), reinterpret_cast<const char*>(snapshot.organisms.data()),
+		reinterpret_cast<const char*>(snapshot.organisms.data() + genomes));
+	prefix.resize(align_up(prefix.size(), 8));
+	prefix.insert(prefix.end(), reinterpret_cast<const char*>(directory.data()),
+		reinterpret_cast<const char*>(directory.data() + directory.size()));
+	prefix.resize(data_offset);
+
+	// write to a uniquely named temporary file, then rename so that readers never map a partial archive
+	auto archive_path = get_timestep_path(path, snapshot.timestep);
+	try {
+		fs::path final_path(archive_path);
+		auto directory_path = final_path.parent_path().empty() ? fs::path(".") : final_path.parent_path();
+		fs::create_directories(directory_path);
+		auto temporary_path = directory_path / fs::unique_path(final_path.filename().string() + ".%%%%%%%%.tmp");
+		{
+			fs::ofstream file(temporary_path, ios::binary | ios::trunc);
+			file.write(prefix.data(), prefix.size());
+			file.write(data.data(), data.size());
+			if (!file) {
+				cerr << "Writing genome archive " << archive_path << " failed\n";
+				file.close();
+				fs::remove(temporary_path);
+				return;
+			}
+		}
+		fs::rename(temporary_path, final_path);
+	}
+	catch (const fs::filesystem_error& e) {
+		cerr << "Writing genome archive failed: " << e.what() << "\n";
+		return;
+	}
+
+	auto values = static_cast<double>(snapshot.genes.size());
+	cout << "Wrote genome archive " << archive_path << " at timestep " << snapshot.timestep << " ("
+		<< genomes << " genomes, " << snapshot.genes.size() * sizeof(float) / 1024 << " KiB of genes stored in "
+		<< (prefix.size() + data.size()) / 1024 << " KiB as " << get_genome_precision_name(precision) << " with "
+		<< get_genome_compression_name(compression) << " compression, max error " << max_error << ", RMS error "
+		<< (values > 0 ? std::sqrt(squared_error / values) : 0) << ", "
+		<< duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0 << " ms)\n";
+}
+
+// encode one block of genomes gene-major at the archive precision into raw bytes,
+// adding squared quantization error and updating maximum error
+void GeneticSimulation::GenomeArchiveWriter::encode_block(const Snapshot& snapshot, size_t first, size_t count,
+	vector<char>& raw, double& squared_error, double& max_error) const
+{
+	auto genes = snapshot.genes_per_genome;
+	auto gene = [&](size_t genome, size_t g) { return snapshot.genes[(first + genome) * genes + g]; };
+	auto add_error = [&](float value, float decoded) {
+		double error = std::abs(static_cast<double>(value) - decoded);
+		squared_error += error * error;
+		max_error = std::max(max_error, error);
+	};
+	raw.clear();
+
+	switch (precision) {
+	case float16_genes:
+		for (size_t g = 0; g < genes; g++) {
+			for (size_t i = 0; i < count; i++) {
+				auto half = float_to_half(gene(i, g));
+				add_error(gene(i, g), half_to_float(half));
+				append(raw, half);
+			}
+		}
+		break;
+	case int8_genes: {
+		// scale each gene by its largest magnitude in the block so that it spans -127 to 127
+		vector<float> scales(genes);
+		for (size_t g = 0; g < genes; g++) {
+			float max_magnitude = 0;
+			for (size_t i = 0; i < count; i++) {
+				max_magnitude = std::max(max_magnitude, std::abs(gene(i, g)));
+			}
+			scales[g] = max_magnitude > 0 ? max_magnitude / 127 : 1;
+		}
+		raw.insert(raw.end(), reinterpret_cast<const char*>(scales.data()),
+			reinterpret_cast<const char*>(scales.data() + genes));
+		for (size_t g = 0; g < genes; g++) {
+			for (size_t i = 0; i < count; i++) {
+				auto quantized = static_cast<int8_t>(std::lround(std::min(127.f, std::max(-127.f, gene(i, g) / scales[g]))));
+				add_error(gene(i, g), quantized * scales[g]);
+				append(raw, quantized);
+			}
+		}
+		break;
+	}
+	default:
+		for (size_t g = 0; g < genes; g++) {
+			for (size_t i = 0; i < count; i++) {
+				append(raw, gene(i, g));
+			}
+		}
+		break;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "GenomeArchiveFormat.h"
+#include "Population.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace GeneticSimulation
+{
+	// Writes archives of every live genome, copying genes into a snapshot buffer at the end of
+	// a timestep and leaving quantization, compression and writing to a background thread
+	class GenomeArchiveWriter
+	{
+	public:
+
+		// constructor which takes the path archive file names are based on, the precision and
+		// compression of genes, the number of genomes per block and the behaviour net layer sizes
+		GenomeArchiveWriter(const std::string& path, genome_precision precision, genome_compression compression,
+			unsigned int genomes_per_block, unsigned int nh1, unsigned int nh2);
+
+		// destructor which finishes writing any snapshot and stops the thread
+		~GenomeArchiveWriter();
+
+		// copy genes of every live organism to be archived in the background (should only be called
+		// while no simulation thread is running), returning false if the previous snapshot has not yet
+		// been picked up for writing
+		bool snapshot(unsigned int timestep, const Population& population);
+
+		// wait until all snapshots have been written
+		void wait_until_idle();
+
+	private:
+
+		// genes of live organisms at a timestep
+		struct Snapshot
+		{
+			unsigned int timestep = 0;
+			unsigned int genes_per_genome = 0;
+			std::vector<uint32_t> organisms;
+			std::vector<float> genes;
+		};
+
+		// write snapshots until stopped
+		void run();
+
+		// quantize and compress snapshot into blocks and write archive
+		void write(const Snapshot& snapshot);
+
+		// encode one block of genomes gene-major at the archive precision into raw bytes,
+		// adding squared quantization error and updating maximum error
+		void encode_block(const Snapshot& snapshot, std::size_t first, std::size_t count,
+			std::vector<char>& raw, double& squared_error, double& max_error) const;
+
+		// path archive file names are based on
+		const std::string path;
+		// precision and compression of genes, and genomes per block
+		const genome_precision precision;
+		const genome_compression compression;
+		const unsigned int genomes_per_block;
+		// behaviour net layer sizes
+		const unsigned int layer_sizes[4];
+		// snapshot being filled and snapshot being written
+		Snapshot pending;
+		Snapshot writing;
+		// whether pending snapshot is waiting to be written, whether a snapshot is being written
+		// and whether thread should stop
+		bool has_pending;
+		bool is_writing;
+		bool stop;
+		// mutex and condition variables for submitting snapshots and waiting for them to be written
+		std::mutex mx;
+		std::condition_variable snapshot_submitted;
+		std::condition_variable snapshot_written;
+		// background thread writing archives
+		std::thread writer_thread;
+	};
+}
@@ -0,0 +1,143 @@
+#include "LineageLog.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+
+using namespace GeneticSimulation;
+
+static_assert(sizeof(LineageEvent) == 32, "lineage event must be 32 bytes");
+
+// identifier and format version of lineage logs
+static const char lineage_magic[8] = "GSLINEG";
+static const uint32_t lineage_version = 1;
+
+// constructor which takes the minimum capacity of the ring buffer
+GeneticSimulation::LineageThreadLog::LineageThreadLog(unsigned int capacity) :
+	events(capacity), timestep(0), dropped(0) {}
+
+// set timestep of events recorded from now on, after all events of earlier timesteps
+// have been recorded (producer only)
+void GeneticSimulation::LineageThreadLog::set_timestep(unsigned int t)
+{
+	timestep.store(t, memory_order_release);
+}
+
+// record an event at the current timestep (producer only)
+void GeneticSimulation::LineageThreadLog::record(lineage_event_type type, unsigned int slot, uint64_t organism,
+	uint64_t related, float weighting)
+{
+	LineageEvent event = {};
+	event.organism = organism;
+	event.related = related;
+	event.timestep = timestep.load(memory_order_relaxed);
+	event.slot = slot;
+	event.weighting = weighting;
+	event.type = type;
+	if (!events.try_push(event)) {
+		dropped.fetch_add(1, memory_order_relaxed);
+	}
+}
+
+// constructor which takes the file path, number of simulation threads, minimum ring buffer
+// capacity per thread and the timestep events start at
+GeneticSimulation::LineageLog::LineageLog(const string& path, unsigned int threads, unsigned int ring_capacity,
+	unsigned int start_timestep) :
+	path(path), written(0), stop(false)
+{
+	for (unsigned int i = 0; i < threads; i++) {
+		this->threads.push_back(std::make_unique<LineageThreadLog>(ring_capacity));
+		this->threads.back()->set_timestep(start_timestep);
+	}
+	pending.reserve(static_cast<size_t>(threads) * ring_capacity);
+
+	file.open(path, ios::binary | ios::trunc);
+	if (!file) {
+		cerr << "Opening lineage log " << path << " failed: Check that the path exists and may be written to\n";
+		return;
+	}
+	uint32_t record_size = sizeof(LineageEvent);
+	file.write(lineage_magic, sizeof(lineage_magic));
+	file.write(reinterpret_cast<const char*>(&lineage_version), sizeof(lineage_version));
+	file.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+	writer_thread = std::thread([this] { run(); });
+}
+
+// destructor which writes all recorded events and stops the thread
+GeneticSimulation::LineageLog::~LineageLog()
+{
+	if (!writer_thread.joinable()) return;
+	stop = true;
+	writer_thread.join();
+	unsigned long long dropped = 0;
+	for (auto& t : threads) {
+		dropped += t->dropped.load(memory_order_relaxed);
+	}
+	cout << "Wrote " << written << " lineage events to " << path;
+	if (dropped > 0) {
+		cout << " (" << dropped << " events dropped as writing could not keep up)";
+	}
+	cout << "\n";
+}
+
+// get whether file was opened
+bool GeneticSimulation::LineageLog::is_open() const
+{
+	return writer_thread.joinable();
+}
+
+// get ring buffer of a simulation thread
+GeneticSimulation::LineageThreadLog& GeneticSimulation::LineageLog::get_thread(unsigned int i)
+{
+	return *threads[i];
+}
+
+// merge and write events until stopped
+void GeneticSimulation::LineageLog::run()
+{
+	LineageEvent event;
+	while (true) {
+		// read stop flag before draining so that events recorded before stopping are written
+		bool stopping = stop;
+		// every thread has recorded all events of timesteps before the earliest one being recorded,
+		// so read timesteps before draining and only write events before that timestep
+		uint32_t complete_before = UINT32_MAX;
+		for (auto& t : threads) {
+			complete_before = std::min(complete_before, t->timestep.load(memory_order_acquire));
+		}
+		for (auto& t : threads) {
+			while (t->events.try_pop(event)) {
+				pending.push_back(event);
+			}
+		}
+		write_events(stopping ? UINT32_MAX : complete_before);
+		if (stopping) break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	file.close();
+	if (!file) {
+		cerr << "Writing lineage log " << path << " failed\n";
+	}
+}
+
+// write merged events of timesteps before the given one (or all if stopping)
+void GeneticSimulation::LineageLog::write_events(uint32_t before_timestep)
+{
+	// order by timestep, keeping each thread's events in the order they were recorded
+	std::stable_sort(pending.begin(), pending.end(),
+		[](const LineageEvent& a, const LineageEvent& b) { return a.timestep < b.timestep; });
+	auto end = before_timestep == UINT32_MAX ? pending.end() : std::lower_bound(pending.begin(), pending.end(),
+		before_timestep, [](const LineageEvent& e, uint32_t t) { return e.timestep < t; });
+	auto count = static_cast<size_t>(end - pending.begin());
+	file.write(reinterpret_cast<const char*>(pending.data()), count * sizeof(LineageEvent));
+	written += count;
+	pending.erase(pending.begin(), end);
+}
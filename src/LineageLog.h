@@ -0,0 +1,106 @@
+#pragma once
+
+#include "helper/SpscQueue.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <cstdint>
+
+namespace GeneticSimulation
+{
+	// types of lineage event
+	enum lineage_event_type : uint8_t { birth_event, death_event, gene_transfer_event };
+
+	// a birth, death or gene transfer, where the related organism is the parent of a birth or
+	// the donor of a gene transfer (0 for a death), and the weighting is the fraction of the
+	// donor's genes transferred (1 for a birth, 0 for a death)
+	struct LineageEvent
+	{
+		uint64_t organism;
+		uint64_t related;
+		uint32_t timestep;
+		uint32_t slot;
+		float weighting;
+		uint8_t type;
+		uint8_t reserved[3];
+	};
+
+	// Ring buffer of lineage events recorded by one simulation thread, which records events
+	// without blocking or allocating (events are dropped if the ring buffer is full)
+	class LineageThreadLog
+	{
+	public:
+
+		// constructor which takes the minimum capacity of the ring buffer
+		explicit LineageThreadLog(unsigned int capacity);
+
+		// set timestep of events recorded from now on, after all events of earlier timesteps
+		// have been recorded (producer only)
+		void set_timestep(unsigned int t);
+
+		// record an event at the current timestep (producer only)
+		void record(lineage_event_type type, unsigned int slot, uint64_t organism, uint64_t related,
+			float weighting);
+
+	private:
+
+		friend class LineageLog;
+
+		// ring buffer of events
+		SpscQueue<LineageEvent> events;
+		// timestep of events being recorded
+		std::atomic<uint32_t> timestep;
+		// number of events dropped as the ring buffer was full
+		std::atomic<unsigned long long> dropped;
+	};
+
+	// Collects lineage events from a ring buffer per simulation thread, which a background
+	// thread merges in timestep order and appends to a file. The file consists of a header of
+	// magic "GSLINEG\0", uint32 version and uint32 record size, followed by LineageEvent records
+	// of 32 bytes each, with all values little-endian
+	class LineageLog
+	{
+	public:
+
+		// constructor which takes the file path, number of simulation threads, minimum ring buffer
+		// capacity per thread and the timestep events start at
+		LineageLog(const std::string& path, unsigned int threads, unsigned int ring_capacity,
+			unsigned int start_timestep);
+
+		// destructor which writes all recorded events and stops the thread
+		~LineageLog();
+
+		// get whether file was opened
+		bool is_open() const;
+
+		// get ring buffer of a simulation thread
+		LineageThreadLog& get_thread(unsigned int i);
+
+	private:
+
+		// merge and write events until stopped
+		void run();
+
+		// write merged events of timesteps before the given one (or all if stopping)
+		void write_events(uint32_t before_timestep);
+
+		// path of log file
+		const std::string path;
+		// log file
+		std::ofstream file;
+		// ring buffer of each simulation thread
+		std::vector<std::unique_ptr<LineageThreadLog>> threads;
+		// events popped from ring buffers but not yet written, as some thread may still record
+		// events of the same timestep
+		std::vector<LineageEvent> pending;
+		// number of events written
+		unsigned long long written;
+		// whether thread should stop
+		std::atomic<bool> stop;
+		// background thread merging and writing events
+		std::thread writer_thread;
+	};
+}
@@ -19,7 +19,7 @@ using namespace GeneticSimulation;
 GeneticSimulation::Organism::Organism(unsigned int index,
 	SimulationArea& area, const Config& config) :
 	// initialize base class object and unique index
-	SimulationObject(area), index(index),
+	SimulationObject(area), index(index), id(0),
 	// initialize genotype
 	genotype(7, config.behaviour_net_layer_1_units, config.behaviour_net_layer_2_units, 2),
 	// initialize phenotype with population-wide parameters
@@ -38,13 +38,14 @@ GeneticSimulation::Organism::Organism(unsigned int index,
 	genes_transferred(false), transfer_effect_time(-1)
 {
 	// set up sprite outline
-	set_sprite_outline_thickness(-1.5f);
+	set_sprite_outline_thickness(get_outline_thickness());
 }
 
 // copy constructor (to allow storing in SimulationObjectPool vector)
 GeneticSimulation::Organism::Organism(const Organism& rhs) :
 	SimulationObject(rhs),
 	index(rhs.index),
+	id(rhs.id),
 	genotype(rhs.genotype),
 	phenotype(rhs.phenotype),
 	sensory_data(rhs.sensory_data),
@@ -57,12 +58,14 @@ GeneticSimulation::Organism::Organism(const Organism& rhs) :
 	genes_transferred(rhs.genes_transferred),
 	transfer_effect_time(rhs.transfer_effect_time) {}
 
-// reset and initialize as fresh organism
-void GeneticSimulation::Organism::init(sf::Vector2f pos, const Config& config, 
+// reset and initialize as fresh organism with the given unique id
+void GeneticSimulation::Organism::init(uint64_t id, sf::Vector2f pos, const Config& config, 
 	default_random_engine& rng)
 {
 	// reset necessary status items
 	reset();
+	// set id
+	this->id = id;
 	// set position
 	set_position(pos);
 	// initialize random genotype
@@ -76,12 +79,14 @@ void GeneticSimulation::Organism::init(sf::Vector2f pos, const Config& config,
 	set_exists(true);
 }
 
-// reset and initialize based on two parent organisms
-void GeneticSimulation::Organism::init_from(const Organism& parent1, 
+// reset and initialize based on two parent organisms with the given unique id
+void GeneticSimulation::Organism::init_from(uint64_t id, const Organism& parent1, 
 	const Organism& parent2, const Config& config, default_random_engine& rng)
 {
 	// reset necessary status items
 	reset();
+	// set id
+	this->id = id;
 	// position is average of parents
 	set_position((parent1.get_position() + parent2.get_position()) / 2.f);
 	// initialize genotype from parents
@@ -96,12 +101,14 @@ void GeneticSimulation::Organism::init_from(const Organism& parent1,
 	set_exists(true);
 }
 
-// reset and initialize based on single parent organism
-void GeneticSimulation::Organism::init_from(const Organism& parent,
+// reset and initialize based on single parent organism with the given unique id
+void GeneticSimulation::Organism::init_from(uint64_t id, const Organism& parent,
 	const Config& config, default_random_engine& rng)
 {
 	// reset necessary status items
 	reset();
+	// set id
+	this->id = id;
 	// set position from parent
 	set_position(parent.get_position());
 	// initialize genotype from parent
@@ -116,14 +123,18 @@ void GeneticSimulation::Organism::init_from(const Organism& parent,
 	set_exists(true);
 }
 
-// interact with another organism if close enough
-void GeneticSimulation::Organism::interact_with(Organism& other,
-	default_random_engine& rng)
+// interact with another organism if close enough, returning whether genes were transferred
+// and setting the weighting of the other organism's genes if they were
+bool GeneticSimulation::Organism::interact_with(Organism& other,
+	default_random_engine& rng, float& weighting)
 {
 	// return if not alive
-	if (!get_exists()) return;
+	if (!get_exists()) return false;
 	// clear corresponding collision status and return if other is not alive
-	if (!other.get_exists()) { collisions[other.index] = 0; return; }
+	if (!other.get_exists()) { collisions[other.index] = 0; return false; }
+
+	// whether genes were transferred
+	bool transferred = false;
 
 	// if collision occurred and was not previously ongoing, and other is older than 250
 	auto collision = check_in_range(other, true);
@@ -133,20 +144,24 @@ void GeneticSimulation::Organism::interact_with(Organism& other,
 		auto chance_of_transfer = (fitness * 0.35f + other.fitness * 0.65f) / 10.f;
 		if (dist_transfer(rng) < chance_of_transfer) {
 			// determine how much of other genotype to transfer
-			auto weighting = (((other.fitness - fitness) / 2.f) + 0.5f) / 5.f;
+			weighting = (((other.fitness - fitness) / 2.f) + 0.5f) / 5.f;
 			// transfer information
 			genotype.transfer_from(other.genotype, weighting);
 			// record transfer
 			genes_transferred = true;
 			transfer_effect_time = 0;
+			transferred = true;
 		}
 	}
 	// record collision status
 	collisions[other.index] = collision;
+	// return whether genes were transferred
+	return transferred;
 }
 
 // set physical integrity and heading to best temperature based on surrounding temperature
-void GeneticSimulation::Organism::react_to_temperature(const Planet& planet, unsigned int time)
+// (temperatures are given for each y coordinate at the current timestep)
+void GeneticSimulation::Organism::react_to_temperature(const float* temperatures)
 {
 	// return if not alive
 	if (!get_exists()) return;
@@ -154,7 +169,7 @@ void GeneticSimulation::Organism::react_to_temperature(const Planet& planet, uns
 	// get position
 	auto position = get_position();
 	// get temperature at current position
-	auto current_temp = planet.get_temperature(static_cast<unsigned int>(position.y), time);
+	auto current_temp = temperatures[static_cast<unsigned int>(position.y)];
 	// get difference between current temp and ideal temp
 	auto temp_d = abs(current_temp - phenotype.get_ideal_temp());
 	// calculate impact on integrity
@@ -165,10 +180,10 @@ void GeneticSimulation::Organism::react_to_temperature(const Planet& planet, uns
 	sensory_data.set_temperature_damage(integrity);
 
 	// get temperature north of current position
-	auto north_temperature = planet.get_temperature(max(0, static_cast<int>(position.y) - 5), time);
+	auto north_temperature = temperatures[max(0, static_cast<int>(position.y) - 5)];
 	// get temperature south of current position
-	auto south_temperature = planet.get_temperature(min(static_cast<int>(get_area_size().y) - 1,
-		static_cast<int>(position.y) + 5), time);
+	auto south_temperature = temperatures[min(static_cast<int>(get_area_size().y) - 1,
+		static_cast<int>(position.y) + 5)];
 	// calculate which direction is more habitable temperature and set heading
 	auto north_d = abs(north_temperature - phenotype.get_ideal_temp());
 	auto south_d = abs(south_temperature - phenotype.get_ideal_temp());
@@ -229,26 +244,30 @@ bool GeneticSimulation::Organism::update_fitness()
 	return get_exists();
 }
 
-// determine distance and heading to closest food item
-void GeneticSimulation::Organism::search_for_food(const ConsumableResourcePool& food)
+// determine distance and heading to closest food item, returning number of items scanned
+unsigned int GeneticSimulation::Organism::search_for_food(const ConsumableResourcePool& food)
 {
 	// return if not alive
-	if (!get_exists()) return;
+	if (!get_exists()) return 0;
 
 	// calculate and save heading to nearest food as well as hunger value
-	sensory_data.set_food_heading(get_heading_to_nearest_resource(food));
+	unsigned int scanned = 0;
+	sensory_data.set_food_heading(get_heading_to_nearest_resource(food, scanned));
 	sensory_data.set_hunger(nutrition);
+	return scanned;
 }
 
-// determine distance and heading to closest water item
-void GeneticSimulation::Organism::search_for_water(const ConsumableResourcePool& water)
+// determine distance and heading to closest water item, returning number of items scanned
+unsigned int GeneticSimulation::Organism::search_for_water(const ConsumableResourcePool& water)
 {
 	// return if not alive
-	if (!get_exists()) return;
+	if (!get_exists()) return 0;
 
 	// calculate and save heading to nearest water as well as thrist value
-	sensory_data.set_water_heading(get_heading_to_nearest_resource(water));
+	unsigned int scanned = 0;
+	sensory_data.set_water_heading(get_heading_to_nearest_resource(water, scanned));
 	sensory_data.set_thirst(hydration);
+	return scanned;
 }
 
 // set heading (velocity) based on sensory data
@@ -292,9 +311,9 @@ void GeneticSimulation::Organism::update_sprite(unsigned int fps)
 	}
 
 	// set sprite color based on fitness
-	set_sprite_color(calculate_color());
+	set_sprite_color(calculate_color(get_health()));
 	// set sprite outline color based on whether gene transfer recently occurred
-	set_sprite_outline_color(calculate_outline_color(fps * 1.5f));
+	set_sprite_outline_color(calculate_outline_color(get_transfer_effect_progress(fps * 1.5f)));
 }
 
 // get index
@@ -303,6 +322,12 @@ unsigned int GeneticSimulation::Organism::get_index() const
 	return index;
 }
 
+// get id unique among all organisms of the simulation (0 before initialization)
+uint64_t GeneticSimulation::Organism::get_id() const
+{
+	return id;
+}
+
 // get fitness
 float GeneticSimulation::Organism::get_fitness() const
 {
@@ -315,12 +340,87 @@ unsigned int GeneticSimulation::Organism::get_age() const
 	return age;
 }
 
+// get physical traits
+const GeneticSimulation::Phenotype& GeneticSimulation::Organism::get_phenotype() const
+{
+	return phenotype;
+}
+
+// get genotype
+const GeneticSimulation::Genotype& GeneticSimulation::Organism::get_genotype() const
+{
+	return genotype;
+}
+
+// get health from 0 to 1 as the lowest of nutrition, hydration and integrity
+float GeneticSimulation::Organism::get_health() const
+{
+	return static_cast<float>(min(one_million, max(0, min({ nutrition.load(), hydration.load(), integrity })))) / 1e6f;
+}
+
+// get progress from 0 to 1 of gene transfer graphical effect of the given length (-1 if inactive)
+float GeneticSimulation::Organism::get_transfer_effect_progress(float effect_len) const
+{
+	return transfer_effect_time >= 0 ? static_cast<float>(transfer_effect_time) / effect_len : -1.f;
+}
+
+// set sprite colors for a health and gene transfer effect progress from a replay frame
+void GeneticSimulation::Organism::set_replay_colors(float health, float effect_progress)
+{
+	set_sprite_color(calculate_color(health));
+	set_sprite_outline_color(calculate_outline_color(effect_progress));
+}
+
 // manually set collision status
 void GeneticSimulation::Organism::set_collision(unsigned int i)
 {
 	collisions[i] = 1;
 }
 
+// add heap memory used by collision record, genotype and sensory data to a footprint
+void GeneticSimulation::Organism::add_memory_usage(MemoryFootprint& footprint) const
+{
+	footprint.add("population_collisions", collisions.capacity() * sizeof(uint8_t));
+	footprint.add("population_genotypes", genotype.get_memory_usage());
+	footprint.add("population_sensory_data", sensory_data.get_memory_usage());
+}
+
+// write object state, genes, traits, senses, physical state and contacts to a checkpoint
+void GeneticSimulation::Organism::write_checkpoint(CheckpointWriter& writer) const
+{
+	SimulationObject::write_checkpoint(writer);
+	writer.write(id);
+	genotype.write_checkpoint(writer);
+	phenotype.write_checkpoint(writer);
+	sensory_data.write_checkpoint(writer);
+	writer.write(age);
+	writer.write(nutrition.load());
+	writer.write(hydration.load());
+	writer.write(integrity);
+	writer.write(fitness);
+	writer.write_vector(collisions);
+	writer.write(genes_transferred);
+	writer.write(transfer_effect_time);
+}
+
+// read object state, genes, traits, senses, physical state and contacts from a checkpoint
+void GeneticSimulation::Organism::read_checkpoint(CheckpointReader& reader)
+{
+	SimulationObject::read_checkpoint(reader);
+	reader.read(id);
+	genotype.read_checkpoint(reader);
+	phenotype.read_checkpoint(reader);
+	sensory_data.read_checkpoint(reader);
+	reader.read(age);
+	nutrition = reader.read<int>();
+	hydration = reader.read<int>();
+	reader.read(integrity);
+	reader.read(fitness);
+	reader.read_vector(collisions);
+	reader.read(genes_transferred);
+	reader.read(transfer_effect_time);
+}
+
 // reset any properties not overwritten each time step
 void GeneticSimulation::Organism::reset()
 {
@@ -338,22 +438,26 @@ void GeneticSimulation::Organism::reset()
 	transfer_effect_time = -1;
 }
 
-// calculate color based on fitness
-sf::Color GeneticSimulation::Organism::calculate_color()
+// calculate color based on health
+sf::Color GeneticSimulation::Organism::calculate_color(float health)
 {
-	// set gradient from red to green based on fitness
-	return calculate_gradient(sf::Color(193, 21, 21, 128), sf::Color(5, 252, 83, 128),
-		static_cast<float>(min(one_million, max(0, min({ nutrition.load(), hydration.load(), integrity })))) / 1e6f);
+	// set gradient from red to green based on health
+	return calculate_gradient(sf::Color(193, 21, 21, 128), sf::Color(5, 252, 83, 128), health);
 }
 
-// calculate outline color
-sf::Color GeneticSimulation::Organism::calculate_outline_color(float transfer_effect_len)
+// get outline thickness of sprite (negative to draw inwards)
+float GeneticSimulation::Organism::get_outline_thickness()
+{
+	return -1.5f;
+}
+
+// calculate outline color based on gene transfer effect progress (-1 if inactive)
+sf::Color GeneticSimulation::Organism::calculate_outline_color(float effect_progress)
 {
 	// normal outline color
 	sf::Color normal_outline(138, 31, 89, 200);
-	// set outline color as gradient based on gene transfer effect time if active
-	if (transfer_effect_time >= 0) {
-		auto effect_progress = static_cast<float>(transfer_effect_time) / transfer_effect_len;
+	// set outline color as gradient based on gene transfer effect progress if active
+	if (effect_progress >= 0) {
 		return calculate_gradient(sf::Color(5, 21, 252, 200), normal_outline, effect_progress);
 	}
 	else {
@@ -361,8 +465,9 @@ sf::Color GeneticSimulation::Organism::calculate_outline_color(float transfer_ef
 	}
 }
 
-// get heading to nearest resource item
-float GeneticSimulation::Organism::get_heading_to_nearest_resource(const ConsumableResourcePool& pool)
+// get heading to nearest resource item, counting number of items scanned
+float GeneticSimulation::Organism::get_heading_to_nearest_resource(const ConsumableResourcePool& pool,
+	unsigned int& scanned)
 {
 	// shortest distance
 	auto shortest_distance = numeric_limits<float>::max();
@@ -380,6 +485,8 @@ float GeneticSimulation::Organism::get_heading_to_nearest_resource(const Consuma
 	for (unsigned int i = 0; i < pool.get_max_size(); i++) {
 		// if item exists
 		if (pool[i].get_exists()) {
+			// count item as scanned
+			scanned++;
 			// get position of item
 			resource_pos = pool[i].get_position();
 			// calculate x and y distances to resource
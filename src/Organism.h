@@ -8,6 +8,7 @@
 #include "SensoryData.h"
 #include "Planet.h"
 #include "ConsumableResourcePool.h"
+#include "helper/MemoryFootprint.h"
 #include <random>
 #include <vector>
 #include <atomic>
@@ -27,21 +28,22 @@ namespace GeneticSimulation
 		// copy constructor (to allow storing in SimulationObjectPool vector)
 		Organism(const Organism& rhs);
 
-		// reset and initialize as fresh organism
-		void init(sf::Vector2f pos, const Config& config, std::default_random_engine& rng);
+		// reset and initialize as fresh organism with the given unique id
+		void init(uint64_t id, sf::Vector2f pos, const Config& config, std::default_random_engine& rng);
 
-		// reset and initialize based on two parent organisms
-		void init_from(const Organism& parent1, const Organism& parent2,
+		// reset and initialize based on two parent organisms with the given unique id
+		void init_from(uint64_t id, const Organism& parent1, const Organism& parent2,
 			const Config& config, std::default_random_engine& rng);
 
-		// reset and initialize based on single parent organism
-		void init_from(const Organism& parent, const Config& config, std::default_random_engine& rng);
+		// reset and initialize based on single parent organism with the given unique id
+		void init_from(uint64_t id, const Organism& parent, const Config& config, std::default_random_engine& rng);
 
-		// interact with another organism if close enough
-		void interact_with(Organism& other, std::default_random_engine& rng);
+		// interact with another organism if close enough, returning whether genes were transferred
+		// and setting the weighting of the other organism's genes if they were
+		bool interact_with(Organism& other, std::default_random_engine& rng, float& weighting);
 
 		// set physical integrity and heading to best temperature based on surrounding temperature
-		void react_to_temperature(const Planet& planet, unsigned int time);
+		void react_to_temperature(const float* temperatures);
 
 		// increase nutrition (atomic)
 		void nourish(unsigned int amount);
@@ -55,11 +57,11 @@ namespace GeneticSimulation
 		// update fitness and existence status
 		bool update_fitness();
 
-		// determine distance and heading to closest food item
-		void search_for_food(const ConsumableResourcePool& food);
+		// determine distance and heading to closest food item, returning number of items scanned
+		unsigned int search_for_food(const ConsumableResourcePool& food);
 
-		// determine distance and heading to closest water item
-		void search_for_water(const ConsumableResourcePool& water);
+		// determine distance and heading to closest water item, returning number of items scanned
+		unsigned int search_for_water(const ConsumableResourcePool& water);
 
 		// set heading (velocity) based on sensory data
 		void think();
@@ -73,15 +75,51 @@ namespace GeneticSimulation
 		// get index
 		unsigned int get_index() const;
 
+		// get id unique among all organisms of the simulation (0 before initialization)
+		uint64_t get_id() const;
+
 		// get fitness
 		float get_fitness() const;
 
 		// get age
 		unsigned int get_age() const;
 
+		// get physical traits
+		const Phenotype& get_phenotype() const;
+
+		// get genotype
+		const Genotype& get_genotype() const;
+
+		// get health from 0 to 1 as the lowest of nutrition, hydration and integrity
+		float get_health() const;
+
+		// get progress from 0 to 1 of gene transfer graphical effect of the given length (-1 if inactive)
+		float get_transfer_effect_progress(float effect_len) const;
+
+		// set sprite colors for a health and gene transfer effect progress from a replay frame
+		void set_replay_colors(float health, float effect_progress);
+
+		// calculate color based on health
+		static sf::Color calculate_color(float health);
+
+		// calculate outline color based on gene transfer effect progress (-1 if inactive)
+		static sf::Color calculate_outline_color(float effect_progress);
+
+		// get outline thickness of sprite (negative to draw inwards)
+		static float get_outline_thickness();
+
 		// manually set collision status
 		void set_collision(unsigned int i);
 
+		// add heap memory used by collision record, genotype and sensory data to a footprint
+		void add_memory_usage(MemoryFootprint& footprint) const;
+
+		// write object state, genes, traits, senses, physical state and contacts to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read object state, genes, traits, senses, physical state and contacts from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 		// function template for checking if an object is within area of influence
 		template<class T>
 		bool check_in_range(const T& item, bool center = false) const
@@ -109,17 +147,13 @@ namespace GeneticSimulation
 		// reset any properties not overwritten each time step
 		void reset();
 
-		// calculate color based on fitness
-		sf::Color calculate_color();
-
-		// calculate outline color
-		sf::Color calculate_outline_color(float effect_len);
-
-		// get heading to nearest resource item
-		float get_heading_to_nearest_resource(const ConsumableResourcePool& pool);
+		// get heading to nearest resource item, counting number of items scanned
+		float get_heading_to_nearest_resource(const ConsumableResourcePool& pool, unsigned int& scanned);
 
 		// index in population
 		const unsigned int index;
+		// id unique among all organisms of the simulation
+		uint64_t id;
 		// collection of genetic information
 		Genotype genotype;
 		// physical traits coded for in genotype
@@ -0,0 +1,40 @@
+#include "PhaseTimer.h"
+#include "helper/allocation_tracker.h"
+#include <chrono>
+
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+using std::chrono::duration_cast;
+using std::memory_order_relaxed;
+
+// constructor which takes metrics and allocation counters to record into (either may be null)
+GeneticSimulation::PhaseTimer::PhaseTimer(SimulationMetrics* metrics, ThreadAllocationCounters* allocations) :
+	metrics(metrics), allocations(allocations), start(steady_clock::now()),
+	start_allocations(get_thread_allocation_count()) {}
+
+// restart timing after waiting on another thread, recording allocations as made while waiting
+void GeneticSimulation::PhaseTimer::reset()
+{
+	if (metrics) start = steady_clock::now();
+	record_allocations(ThreadAllocationCounters::wait_bucket);
+}
+
+// record time and allocations since last lap or reset as the given phase and restart
+void GeneticSimulation::PhaseTimer::lap(simulation_phase p)
+{
+	if (metrics) {
+		auto now = steady_clock::now();
+		metrics->record_phase(p, duration_cast<microseconds>(now - start).count());
+		start = now;
+	}
+	record_allocations(p);
+}
+
+// record allocations since last mark into a bucket
+void GeneticSimulation::PhaseTimer::record_allocations(unsigned int bucket)
+{
+	if (!allocations) return;
+	auto now_allocations = get_thread_allocation_count();
+	allocations->allocations[bucket].fetch_add(now_allocations - start_allocations, memory_order_relaxed);
+	start_allocations = now_allocations;
+}
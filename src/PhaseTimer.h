@@ -0,0 +1,40 @@
+#pragma once
+
+#include "SimulationPhase.h"
+#include "SimulationMetrics.h"
+#include "AllocationCounters.h"
+#include <chrono>
+
+namespace GeneticSimulation
+{
+	// Marks the end of consecutive phases of a simulation thread, recording the duration of
+	// each phase in simulation metrics and the heap allocations made during it in allocation
+	// counters, doing nothing for whichever of these is not given
+	class PhaseTimer
+	{
+	public:
+
+		// constructor which takes metrics and allocation counters to record into (either may be null)
+		PhaseTimer(SimulationMetrics* metrics, ThreadAllocationCounters* allocations);
+
+		// restart timing after waiting on another thread, recording allocations as made while waiting
+		void reset();
+
+		// record time and allocations since last lap or reset as the given phase and restart
+		void lap(simulation_phase p);
+
+	private:
+
+		// record allocations since last mark into a bucket
+		void record_allocations(unsigned int bucket);
+
+		// metrics to record into
+		SimulationMetrics* metrics;
+		// allocation counters to record into
+		ThreadAllocationCounters* allocations;
+		// start of current phase
+		std::chrono::steady_clock::time_point start;
+		// thread allocation count at start of current phase
+		unsigned long long start_allocations;
+	};
+}
@@ -0,0 +1,173 @@
+#include "Phylogeny.h"
+
+using std::lock_guard;
+using std::mutex;
+
+using namespace GeneticSimulation;
+
+// constructor which takes the number of population slots
+GeneticSimulation::Phylogeny::Phylogeny(unsigned int slots) :
+	// every dead node has at least two children and every leaf is alive, so there are fewer dead
+	// nodes than live ones and at most twice as many nodes as slots besides the founders node
+	nodes(2 * static_cast<size_t>(slots) + 1), slot_nodes(slots, no_node), free_node(no_node), used_nodes(0)
+{
+	nodes[founders_node] = { 0, no_node, no_node, no_node, no_node, 0, 0, 1 };
+	for (int32_t n = static_cast<int32_t>(nodes.size()) - 1; n > founders_node; n--) {
+		nodes[n].parent = free_node;
+		free_node = n;
+	}
+}
+
+// record an organism in a slot with no known parent
+void GeneticSimulation::Phylogeny::add_founder(unsigned int slot, uint64_t id, unsigned int timestep)
+{
+	lock_guard<mutex> lock(mx);
+	allocate(slot, id, founders_node, timestep);
+}
+
+// record the birth of an organism in a slot from the live organism in the parent slot
+void GeneticSimulation::Phylogeny::add_birth(unsigned int slot, uint64_t id, unsigned int parent_slot,
+	unsigned int timestep)
+{
+	lock_guard<mutex> lock(mx);
+	allocate(slot, id, slot_nodes[parent_slot], timestep);
+}
+
+// record the death of the organism in a slot, pruning ancestors it kept alive
+void GeneticSimulation::Phylogeny::remove_death(unsigned int slot)
+{
+	lock_guard<mutex> lock(mx);
+	auto n = slot_nodes[slot];
+	if (n == no_node) return;
+	slot_nodes[slot] = no_node;
+	nodes[n].alive = 0;
+	prune(n);
+}
+
+// find the most recent common ancestor of the organisms in two slots (which may be one of
+// them), returning false if a slot is empty or they descend from different founders
+bool GeneticSimulation::Phylogeny::find_common_ancestor(unsigned int slot_a, unsigned int slot_b,
+	PhylogenyAncestor& ancestor) const
+{
+	lock_guard<mutex> lock(mx);
+	auto a = slot_nodes[slot_a];
+	auto b = slot_nodes[slot_b];
+	if (a == no_node || b == no_node) return false;
+	// organisms get increasing ids, so an ancestor always has a lower id than its descendants
+	// and the node with the higher id cannot be an ancestor of the other one
+	while (a != b) {
+		if (nodes[a].id > nodes[b].id) a = nodes[a].parent;
+		else b = nodes[b].parent;
+	}
+	if (a == founders_node) return false;
+	ancestor.id = nodes[a].id;
+	ancestor.birth_timestep = nodes[a].birth_timestep;
+	return true;
+}
+
+// summarize size of the tree and common ancestor of the population
+GeneticSimulation::PhylogenySummary GeneticSimulation::Phylogeny::summarize() const
+{
+	lock_guard<mutex> lock(mx);
+	PhylogenySummary summary;
+	summary.nodes = used_nodes;
+	summary.founder_lineages = nodes[founders_node].children;
+	// a single remaining founder lineage is rooted at a live organism or a branch point,
+	// which is the most recent ancestor of every live organism
+	if (summary.founder_lineages == 1) {
+		auto& root = nodes[nodes[founders_node].first_child];
+		summary.has_common_ancestor = true;
+		summary.common_ancestor.id = root.id;
+		summary.common_ancestor.birth_timestep = root.birth_timestep;
+	}
+	return summary;
+}
+
+// add memory used by nodes and slot record to a footprint
+void GeneticSimulation::Phylogeny::add_memory_usage(MemoryFootprint& footprint) const
+{
+	footprint.add("population_phylogeny", nodes.capacity() * sizeof(Node) + slot_nodes.capacity() * sizeof(int32_t));
+}
+
+// estimate memory used by nodes and slot record for a number of population slots
+std::size_t GeneticSimulation::Phylogeny::estimate_memory_usage(unsigned int slots)
+{
+	return (2 * static_cast<std::size_t>(slots) + 1) * sizeof(Node) + slots * sizeof(int32_t);
+}
+
+// write nodes and slot record to a checkpoint
+void GeneticSimulation::Phylogeny::write_checkpoint(CheckpointWriter& writer)
+{
+	lock_guard<mutex> lock(mx);
+	writer.write_vector(nodes);
+	writer.write_vector(slot_nodes);
+	writer.write(free_node);
+	writer.write(used_nodes);
+}
+
+// read nodes and slot record from a checkpoint
+void GeneticSimulation::Phylogeny::read_checkpoint(CheckpointReader& reader)
+{
+	lock_guard<mutex> lock(mx);
+	reader.read_vector(nodes);
+	reader.read_vector(slot_nodes);
+	reader.read(free_node);
+	reader.read(used_nodes);
+}
+
+// take a free node, set it up as a live organism and put it in a slot
+void GeneticSimulation::Phylogeny::allocate(unsigned int slot, uint64_t id, int32_t parent, unsigned int timestep)
+{
+	auto n = free_node;
+	free_node = nodes[n].parent;
+	nodes[n] = { id, parent, no_node, no_node, no_node, 0, timestep, 1 };
+	link(n);
+	slot_nodes[slot] = n;
+	used_nodes++;
+}
+
+// insert node at the front of its parent's children
+void GeneticSimulation::Phylogeny::link(int32_t n)
+{
+	auto& parent = nodes[nodes[n].parent];
+	nodes[n].previous_sibling = no_node;
+	nodes[n].next_sibling = parent.first_child;
+	if (parent.first_child != no_node) nodes[parent.first_child].previous_sibling = n;
+	parent.first_child = n;
+	parent.children++;
+}
+
+// remove node from its parent's children
+void GeneticSimulation::Phylogeny::unlink(int32_t n)
+{
+	auto& node = nodes[n];
+	auto& parent = nodes[node.parent];
+	if (node.previous_sibling != no_node) nodes[node.previous_sibling].next_sibling = node.next_sibling;
+	else parent.first_child = node.next_sibling;
+	if (node.next_sibling != no_node) nodes[node.next_sibling].previous_sibling = node.previous_sibling;
+	parent.children--;
+}
+
+// remove dead nodes upwards from a node until reaching one which is alive or a branch point
+void GeneticSimulation::Phylogeny::prune(int32_t n)
+{
+	while (n != founders_node && !nodes[n].alive && nodes[n].children < 2) {
+		auto parent = nodes[n].parent;
+		auto child = nodes[n].first_child;
+		bool single_child = nodes[n].children == 1;
+		unlink(n);
+		// splice out ancestor with a single line of descent
+		if (single_child) {
+			nodes[child].parent = parent;
+			link(child);
+		}
+		// free node
+		nodes[n].parent = free_node;
+		free_node = n;
+		used_nodes--;
+		// splicing leaves the parent with as many children as before, while an extinct branch
+		// leaves it with one fewer, so it may now be removable
+		if (single_child) return;
+		n = parent;
+	}
+}
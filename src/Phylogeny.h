@@ -0,0 +1,113 @@
+#pragma once
+
+#include "helper/MemoryFootprint.h"
+#include "helper/Checkpoint.h"
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+namespace GeneticSimulation
+{
+	// an ancestor retained in a phylogeny, identified by organism id
+	struct PhylogenyAncestor
+	{
+		uint64_t id = 0;
+		unsigned int birth_timestep = 0;
+	};
+
+	// size of a phylogeny and the most recent common ancestor of the whole population, which
+	// only exists while every live organism descends from the same founder
+	struct PhylogenySummary
+	{
+		unsigned int nodes = 0;
+		unsigned int founder_lineages = 0;
+		bool has_common_ancestor = false;
+		PhylogenyAncestor common_ancestor;
+	};
+
+	// Tree of descent of the live population, where each live organism is a node whose parent is
+	// its nearest retained ancestor. Ancestors are reference counted by their children: an extinct
+	// branch is removed as soon as its last live descendant dies, and a dead ancestor left with a
+	// single child is spliced out, so every dead node is a branch point and the tree never holds
+	// more than twice as many nodes as there are population slots. Births and deaths may be
+	// recorded from any thread
+	class Phylogeny
+	{
+	public:
+
+		// constructor which takes the number of population slots
+		explicit Phylogeny(unsigned int slots);
+
+		// record an organism in a slot with no known parent
+		void add_founder(unsigned int slot, uint64_t id, unsigned int timestep);
+
+		// record the birth of an organism in a slot from the live organism in the parent slot
+		void add_birth(unsigned int slot, uint64_t id, unsigned int parent_slot, unsigned int timestep);
+
+		// record the death of the organism in a slot, pruning ancestors it kept alive
+		void remove_death(unsigned int slot);
+
+		// find the most recent common ancestor of the organisms in two slots (which may be one of
+		// them), returning false if a slot is empty or they descend from different founders
+		bool find_common_ancestor(unsigned int slot_a, unsigned int slot_b, PhylogenyAncestor& ancestor) const;
+
+		// summarize size of the tree and common ancestor of the population
+		PhylogenySummary summarize() const;
+
+		// add memory used by nodes and slot record to a footprint
+		void add_memory_usage(MemoryFootprint& footprint) const;
+
+		// estimate memory used by nodes and slot record for a number of population slots
+		static std::size_t estimate_memory_usage(unsigned int slots);
+
+		// write nodes and slot record to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer);
+
+		// read nodes and slot record from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
+	private:
+
+		// node index meaning none, and index of the node all founders are children of
+		static const int32_t no_node = -1;
+		static const int32_t founders_node = 0;
+
+		// an organism which is alive or the nearest common ancestor of at least two retained nodes,
+		// with its children kept in a doubly linked list
+		struct Node
+		{
+			uint64_t id;
+			int32_t parent;
+			int32_t first_child;
+			int32_t next_sibling;
+			int32_t previous_sibling;
+			uint32_t children;
+			uint32_t birth_timestep;
+			uint32_t alive;
+		};
+
+		// take a free node, set it up as a live organism and put it in a slot
+		void allocate(unsigned int slot, uint64_t id, int32_t parent, unsigned int timestep);
+
+		// insert node at the front of its parent's children
+		void link(int32_t n);
+
+		// remove node from its parent's children
+		void unlink(int32_t n);
+
+		// remove dead nodes upwards from a node until reaching one which is alive or a branch point
+		void prune(int32_t n);
+
+		// all nodes, with free nodes chained through their parent index and founders as the children
+		// of a permanent node with id 0, which is lower than any organism id
+		std::vector<Node> nodes;
+		// node of the organism in each slot (no_node if empty)
+		std::vector<int32_t> slot_nodes;
+		// first free node
+		int32_t free_node;
+		// number of nodes in use, excluding the founders node
+		uint32_t used_nodes;
+		// mutex protecting nodes from concurrent births, deaths and queries
+		mutable std::mutex mx;
+	};
+}
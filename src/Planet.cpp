@@ -1,6 +1,10 @@
 #include "Planet.h"
+#include "TemperatureModel.h"
+#include "TemperatureCache.h"
+#include "TemperatureSharedMemory.h"
 #include "helper/benchmark_helper.h"
 #include <cmath>
+#include <climits>
 #include <vector>
 #include <chrono>
 #include <string>
@@ -11,6 +15,10 @@
 #endif
 #include <algorithm>
 #include <thread>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <boost/filesystem.hpp>
 #include <boost/math/special_functions/sign.hpp>
 
 using std::vector;
@@ -24,22 +32,67 @@ using std::make_unique;
 using std::min;
 using std::max;
 using std::thread;
+using std::size_t;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::fixed;
+using std::setprecision;
+using std::setw;
+using std::left;
+using std::right;
 
 using namespace GeneticSimulation;
 
+// destination for results of timed lookups so that they are not optimized away
+static volatile float lookup_sink;
+
+// constructor which takes the number of y coordinates
+GeneticSimulation::TemperatureRows::TemperatureRows(unsigned int height) :
+	// none of the rows hold a timestep yet
+	rows(static_cast<size_t>(height) * 2, -1.f), timesteps{ UINT_MAX, UINT_MAX } {}
+
 // default constructor
-GeneticSimulation::Planet::Planet() : initialized(false), timesteps(0) {}
+GeneticSimulation::Planet::Planet() : initialized(false), storage(full_storage), vectorized(true), backend(threads_backend),
+	temperatures_data(nullptr), temperatures_quantized_data(nullptr), quantization_offset(0),
+	quantization_scale(1), tilt_samples(1), surface_factors_per_y(2), temperature_stride(1), samples_per_y(4),
+	interpolation(cubic_interpolation), window_timesteps(1), area_height(0),
+	window_computed(0), window_current(0), window_stop(false), timesteps(0) {}
+
+// destructor which stops computing temperatures in the background
+GeneticSimulation::Planet::~Planet()
+{
+	stop_window_thread();
+}
 
 // precompute temperatures
 void GeneticSimulation::Planet::precompute_temperatures(const Config& config, bool benchmark)
 {
-	// set lookup table to correct size
-	temperatures.resize(config.area_height * config.orbital_period);
-	timesteps = config.orbital_period;
+	// use full or quantized lookup table shared by another process if enabled, otherwise any process
+	// waiting for it waits until this one has published it
+	bool table_storage = config.planet_temperature_storage == full_storage ||
+		config.planet_temperature_storage == quantized_storage;
+	temperature_shared.reset();
+	bool shareable = !benchmark && config.planet_temperature_shared_memory && table_storage;
+	if (shareable && attach_shared_temperatures(config)) {
+		initialized = true;
+		return;
+	}
+
+	// use cached full or quantized lookup table if enabled
+	bool cacheable = !benchmark && !config.planet_temperature_cache_path.empty() && table_storage;
+	if (cacheable && map_temperature_cache(config)) {
+		if (shareable) publish_shared_temperatures();
+		initialized = true;
+		return;
+	}
+
+	// set up lookup tables for configured storage
+	allocate_temperatures(config, config.planet_temperature_storage);
 
 #ifdef GPU_SUPPORT
-	// get whether to use GPU
-	const bool use_cpu = !config.precompute_temperatures_gpu;
+	// get whether to use GPU (which only supports full storage)
+	const bool use_cpu = !config.precompute_temperatures_gpu || storage != full_storage;
 #else
 	constexpr bool use_cpu = true;
 #endif
@@ -50,9 +103,14 @@ void GeneticSimulation::Planet::precompute_temperatures(const Config& config, bo
 		auto num_threads = config.precompute_temperatures_cpu_threads == 0 ?
 			thread::hardware_concurrency() :
 			config.precompute_temperatures_cpu_threads;
-		// benchmark or precompute once
-		benchmark ? benchmark_temperature_computation_cpu(num_threads, config) : 
+		// benchmark and evaluate storage, or precompute once
+		if (benchmark) {
+			benchmark_temperature_computation_cpu(num_threads, config);
+			evaluate_temperature_variants(num_threads, config);
+		}
+		else {
 			precompute_temperatures_cpu(num_threads, config);
+		}
 	}
 #ifdef GPU_SUPPORT
 	else {
@@ -62,30 +120,383 @@ void GeneticSimulation::Planet::precompute_temperatures(const Config& config, bo
 	}
 #endif
 
+	// write lookup table to cache for later runs
+	if (cacheable) {
+		storage == full_storage ?
+			temperature_cache->write(reinterpret_cast<const char*>(temperatures.data()), 
+				temperatures.size() * sizeof(float), quantization_offset, quantization_scale) :
+			temperature_cache->write(reinterpret_cast<const char*>(temperatures_quantized.data()),
+				temperatures_quantized.size() * sizeof(uint16_t), quantization_offset, quantization_scale);
+	}
+
+	// share lookup table with other processes
+	if (shareable) {
+		publish_shared_temperatures();
+	}
+
 	// record initialization
 	initialized = true;
+
+	// report error introduced by interpolating between sampled timesteps
+	if (storage == sampled_storage && !benchmark) {
+		report_sampled_temperature_error(config);
+	}
 }
 
 // get temperature from lookup table
 float GeneticSimulation::Planet::get_temperature(unsigned int y, unsigned int t) const
 {
-	// return -1 if temperatures have not been computed, otherwise return precomputed temperature
-	return initialized ? temperatures[y * timesteps + (t % timesteps)] : -1.f;
+	// return -1 if temperatures have not been computed
+	if (!initialized) return -1.f;
+
+	// return precomputed temperature from selected storage
+	if (storage == windowed_storage) {
+		return window_temperatures[(t % window_timesteps) * area_height + y];
+	}
+	t %= timesteps;
+	switch (storage) {
+	case quantized_storage:
+		return static_cast<float>(quantization_offset + temperatures_quantized_data[y * timesteps + t] * quantization_scale);
+	case factored_storage: {
+		// interpolate surface factor between sampled axial tilts either side of effective tilt at timestep
+		auto position = tilt_positions[t];
+		auto i = static_cast<unsigned int>(position);
+		auto factors = &surface_factors[y * surface_factors_per_y + i];
+		return equatorial_temperatures[t] * (factors[0] + (factors[1] - factors[0]) * (position - i));
+	}
+	case sampled_storage: {
+		// interpolate between samples either side of timestep, with one more either side if cubic
+		auto s = &sampled_temperatures[y * samples_per_y + t / temperature_stride];
+		float f = static_cast<float>(t % temperature_stride) / temperature_stride;
+		if (interpolation == linear_interpolation) {
+			return s[1] + (s[2] - s[1]) * f;
+		}
+		return s[1] + 0.5f * f * (s[2] - s[0] + f * (2.f * s[0] - 5.f * s[1] + 4.f * s[2] - s[3] +
+			f * (3.f * (s[1] - s[2]) + s[3] - s[0])));
+	}
+	default:
+		return temperatures_data[y * timesteps + t];
+	}
+}
+
+// get temperatures for every y coordinate at a timestep
+const float* GeneticSimulation::Planet::get_temperature_row(unsigned int t, TemperatureRows& rows) const
+{
+	// windowed temperatures are already stored time-major
+	if (storage == windowed_storage) {
+		wait_for_window_timestep(t);
+		return &window_temperatures[(t % window_timesteps) * area_height];
+	}
+	// publish row for timestep if it has not been already, alternating between rows so that 
+	// the previous timestep's row can still be read while this one is published
+	auto slot = t % 2;
+	auto row = &rows.rows[slot * area_height];
+	if (rows.timesteps[slot].load(std::memory_order_acquire) != t) {
+		std::lock_guard<std::mutex> lock(rows.mx);
+		if (rows.timesteps[slot].load(std::memory_order_relaxed) != t) {
+			for (unsigned int y = 0; y < area_height; y++) {
+				row[y] = get_temperature(y, t);
+			}
+			rows.timesteps[slot].store(t, std::memory_order_release);
+		}
+	}
+	return row;
+}
+
+// add memory used by temperature lookup table to a footprint
+void GeneticSimulation::Planet::add_memory_usage(MemoryFootprint& footprint) const
+{
+	footprint.add("planet_temperatures", temperatures.capacity() * sizeof(float) + 
+		temperatures_quantized.capacity() * sizeof(uint16_t) +
+		(equatorial_temperatures.capacity() + tilt_positions.capacity() + surface_factors.capacity() +
+			sampled_temperatures.capacity() +
+			window_temperatures.capacity()) * sizeof(float) +
+		(temperature_cache ? temperature_cache->get_mapped_size() : 0) +
+		(temperature_shared ? temperature_shared->get_mapped_size() : 0));
+}
+
+// set up lookup tables for the given storage
+void GeneticSimulation::Planet::allocate_temperatures(const Config& config, temperature_storage selected_storage)
+{
+	stop_window_thread();
+	storage = selected_storage;
+	vectorized = config.precompute_temperatures_vectorized;
+	backend = config.precompute_temperatures_backend;
+	if (!get_compute_backend_available(backend)) {
+		cerr << "Compute backend " << get_compute_backend_name(backend) << " is not available in this build, using threads\n";
+		backend = threads_backend;
+	}
+	timesteps = config.orbital_period;
+	area_height = config.area_height;
+
+	// release tables of any other storage
+	vector<float>().swap(temperatures);
+	vector<uint16_t>().swap(temperatures_quantized);
+	vector<float>().swap(equatorial_temperatures);
+	vector<float>().swap(tilt_positions);
+	vector<float>().swap(surface_factors);
+	vector<float>().swap(sampled_temperatures);
+	vector<float>().swap(window_temperatures);
+
+	// set tables to correct size
+	switch (storage) {
+	case quantized_storage: {
+		temperatures_quantized.resize(static_cast<size_t>(config.area_height) * config.orbital_period);
+		// bound temperatures by the extremes of equatorial temperature over the orbit and of surface 
+		// factor over latitude and tilt, with a margin for tilts falling between those sampled
+		TemperatureModel model(config);
+		double min_equatorial = model.get_equatorial_temperature(0), max_equatorial = min_equatorial;
+		for (unsigned int t = 1; t < config.orbital_period; t++) {
+			auto e = model.get_equatorial_temperature(t);
+			min_equatorial = min(min_equatorial, e);
+			max_equatorial = max(max_equatorial, e);
+		}
+		double min_factor = model.get_surface_factor(model.get_latitude(0), 0), max_factor = min_factor;
+		for (unsigned int y = 0; y < config.area_height; y++) {
+			for (int i = -32; i <= 32; i++) {
+				auto f = model.get_surface_factor(model.get_latitude(y), config.axial_tilt * i / 32.0);
+				min_factor = min(min_factor, f);
+				max_factor = max(max_factor, f);
+			}
+		}
+		double min_temperature = min_equatorial * min_factor;
+		double max_temperature = max_equatorial * max_factor;
+		double margin = (max_temperature - min_temperature) * 0.01;
+		quantization_offset = min_temperature - margin;
+		quantization_scale = max(1e-9, (max_temperature - min_temperature + 2 * margin) / 65535.0);
+		break;
+	}
+	case factored_storage:
+		tilt_samples = config.axial_tilt > 0 ? config.planet_tilt_samples : 1;
+		surface_factors_per_y = tilt_samples + 1;
+		equatorial_temperatures.resize(config.orbital_period);
+		tilt_positions.resize(config.orbital_period);
+		surface_factors.resize(static_cast<size_t>(config.area_height) * surface_factors_per_y);
+		break;
+	case sampled_storage:
+		temperature_stride = min(config.planet_temperature_stride, config.orbital_period);
+		interpolation = config.planet_temperature_interpolation;
+		samples_per_y = (config.orbital_period + temperature_stride - 1) / temperature_stride + 3;
+		sampled_temperatures.resize(static_cast<size_t>(config.area_height) * samples_per_y);
+		break;
+	case windowed_storage:
+		window_timesteps = config.planet_temperature_window;
+		window_temperatures.resize(static_cast<size_t>(config.area_height) * window_timesteps);
+		break;
+	default:
+		temperatures.resize(static_cast<size_t>(config.area_height) * config.orbital_period);
+		break;
+	}
+
+	// read from tables just allocated
+	temperatures_data = temperatures.data();
+	temperatures_quantized_data = temperatures_quantized.data();
+}
+
+// map full or quantized lookup table from cache, returning whether successful
+bool GeneticSimulation::Planet::map_temperature_cache(const Config& config)
+{
+	stop_window_thread();
+	storage = config.planet_temperature_storage;
+	timesteps = config.orbital_period;
+	area_height = config.area_height;
+	temperature_cache = std::make_unique<TemperatureCache>(config.planet_temperature_cache_path, config, storage);
+
+	// map table of expected size
+	size_t cells = static_cast<size_t>(config.area_height) * config.orbital_period;
+	auto data = temperature_cache->map(cells * (storage == full_storage ? sizeof(float) : sizeof(uint16_t)),
+		quantization_offset, quantization_scale);
+	if (!data) return false;
+
+	// read from mapped table
+	temperatures_data = reinterpret_cast<const float*>(data);
+	temperatures_quantized_data = reinterpret_cast<const uint16_t*>(data);
+	return true;
+}
+
+// attach to full or quantized lookup table published in shared memory by another process
+bool GeneticSimulation::Planet::attach_shared_temperatures(const Config& config)
+{
+	stop_window_thread();
+	storage = config.planet_temperature_storage;
+	timesteps = config.orbital_period;
+	area_height = config.area_height;
+	temperature_shared = std::make_unique<TemperatureSharedMemory>(config, storage);
+
+	// map table of expected size
+	size_t cells = static_cast<size_t>(config.area_height) * config.orbital_period;
+	auto data = temperature_shared->attach(cells * (storage == full_storage ? sizeof(float) : sizeof(uint16_t)),
+		quantization_offset, quantization_scale);
+	if (!data) return false;
+
+	// read from shared table, releasing any table of this process
+	vector<float>().swap(temperatures);
+	vector<uint16_t>().swap(temperatures_quantized);
+	temperature_cache.reset();
+	temperatures_data = reinterpret_cast<const float*>(data);
+	temperatures_quantized_data = reinterpret_cast<const uint16_t*>(data);
+	return true;
+}
+
+// publish full or quantized lookup table in shared memory and read it from there instead
+void GeneticSimulation::Planet::publish_shared_temperatures()
+{
+	// table is either in this process's vectors or mapped from cache
+	size_t cells = static_cast<size_t>(area_height) * timesteps;
+	auto data = temperature_shared->publish(storage == full_storage ?
+		reinterpret_cast<const char*>(temperatures_data) : reinterpret_cast<const char*>(temperatures_quantized_data),
+		cells * (storage == full_storage ? sizeof(float) : sizeof(uint16_t)), quantization_offset, quantization_scale);
+	if (!data) {
+		// keep reading this process's table
+		temperature_shared.reset();
+		return;
+	}
+
+	// read from shared table so that this process does not hold a second copy
+	temperatures_data = reinterpret_cast<const float*>(data);
+	temperatures_quantized_data = reinterpret_cast<const uint16_t*>(data);
+	vector<float>().swap(temperatures);
+	vector<uint16_t>().swap(temperatures_quantized);
+	temperature_cache.reset();
+}
+
+// continue from the given timestep instead of the first, such as after restoring a checkpoint
+void GeneticSimulation::Planet::start_at_timestep(unsigned int t, const Config& config)
+{
+	if (storage == windowed_storage && window_thread.joinable()) {
+		start_window_thread(config, t);
+	}
+}
+
+// start computing temperatures for upcoming timesteps from the given timestep in the background
+void GeneticSimulation::Planet::start_window_thread(const Config& config, unsigned int start_timestep)
+{
+	stop_window_thread();
+	window_computed = start_timestep;
+	window_current = start_timestep;
+	window_stop = false;
+	window_thread = thread([this, model = TemperatureModel(config), height = config.area_height] {
+		// latitude of each y coordinate
+		vector<double> latitudes(height);
+		for (unsigned int y = 0; y < height; y++) {
+			latitudes[y] = model.get_latitude(y);
+		}
+		while (true) {
+			// wait until stopped or there is a slot which is not needed by the latest timestep
+			// waited for or the one before it (which may still be drawn)
+			unsigned int t = window_computed.load(std::memory_order_relaxed);
+			{
+				std::unique_lock<std::mutex> lock(window_mutex);
+				window_advanced.wait(lock, [&] {
+					return window_stop || t + 2 < window_current + window_timesteps;
+				});
+				if (window_stop) return;
+			}
+			// compute temperatures for each y coordinate at timestep
+			auto equatorial_temperature = model.get_equatorial_temperature(t % timesteps);
+			auto effective_axial_tilt = model.get_effective_axial_tilt(t % timesteps);
+			auto column = &window_temperatures[static_cast<size_t>(t % window_timesteps) * height];
+			for (unsigned int y = 0; y < height; y++) {
+				column[y] = static_cast<float>(equatorial_temperature *
+					model.get_surface_factor(latitudes[y], effective_axial_tilt));
+			}
+			// publish timestep and wake any threads waiting for it
+			{
+				std::lock_guard<std::mutex> lock(window_mutex);
+				window_computed.store(t + 1, std::memory_order_release);
+			}
+			window_computed_advanced.notify_all();
+		}
+	});
+}
+
+// stop computing temperatures in the background
+void GeneticSimulation::Planet::stop_window_thread()
+{
+	if (!window_thread.joinable()) return;
+	{
+		std::lock_guard<std::mutex> lock(window_mutex);
+		window_stop = true;
+	}
+	window_advanced.notify_all();
+	window_thread.join();
+}
+
+// wait until temperatures for a timestep have been computed in the background
+void GeneticSimulation::Planet::wait_for_window_timestep(unsigned int t) const
+{
+	// allow window thread to evict timesteps before the previous one if this timestep is new
+	if (t > window_current.load(std::memory_order_relaxed)) {
+		{
+			std::lock_guard<std::mutex> lock(window_mutex);
+			window_current.store(std::max(t, window_current.load(std::memory_order_relaxed)),
+				std::memory_order_relaxed);
+		}
+		window_advanced.notify_one();
+	}
+	// return immediately if timestep has already been computed, otherwise wait for it
+	if (window_computed.load(std::memory_order_acquire) > t) return;
+	std::unique_lock<std::mutex> lock(window_mutex);
+	window_computed_advanced.wait(lock, [&] { return window_computed.load(std::memory_order_acquire) > t; });
+}
+
+// store a precomputed temperature in the full or quantized lookup table
+inline void GeneticSimulation::Planet::store_temperature(size_t i, double temperature)
+{
+	if (storage == quantized_storage) {
+		temperatures_quantized[i] = static_cast<uint16_t>(min(65535.0, max(0.0,
+			std::round((temperature - quantization_offset) / quantization_scale))));
+	}
+	else {
+		temperatures[i] = static_cast<float>(temperature);
+	}
 }
 
 // precompute temperatures using the CPU
 void GeneticSimulation::Planet::precompute_temperatures_cpu(unsigned int worker_threads, const Config& config)
 {
-	// calculate number of timesteps per thread
+	// windowed temperatures are computed on demand by a single background thread
+	if (storage == windowed_storage) {
+		start_window_thread(config);
+		return;
+	}
+
+	// calculate number of timesteps and y coordinates per thread
 	unsigned int timesteps_per_thread = timesteps / worker_threads + 1;
+	unsigned int rows_per_thread = config.area_height / worker_threads + 1;
+
+	// compute full or quantized temperatures with the selected backend, either in one tile of 
+	// timesteps per thread or in smaller tiles of both timesteps and y coordinates which are 
+	// balanced between threads by the backend
+	if (storage == full_storage || storage == quantized_storage) {
+		TimestepTerms timestep_terms;
+		if (vectorized) {
+			timestep_terms = TemperatureModel(config).get_timestep_terms(0, timesteps);
+		}
+		bool tiled = backend != threads_backend;
+		parallel_for_tiles(backend, worker_threads, config.area_height, timesteps,
+			tiled ? 32 : config.area_height, tiled ? 2048 : timesteps_per_thread,
+			[&](unsigned int start_y, unsigned int end_y, unsigned int start_t, unsigned int end_t) {
+				vectorized ? 
+					precompute_temperatures_for_range_vectorized(start_t, end_t, start_y, end_y, timestep_terms, config) :
+					precompute_temperatures_for_range_cpu(start_t, end_t, start_y, end_y, config);
+			});
+		return;
+	}
+
 	// create vector for thread objects
 	vector<unique_ptr<thread>> threads;
 	// start threads
 	for (unsigned int i = 0; i < worker_threads; i++) {
 		threads.push_back(make_unique<thread>(
-			[&, timesteps_per_thread, i] {
-				precompute_temperatures_for_timestep_range_cpu(i * timesteps_per_thread,
-					(i + 1) * timesteps_per_thread, config);
+			[&, timesteps_per_thread, rows_per_thread, i] {
+				if (storage == sampled_storage) {
+					precompute_sampled_temperatures_for_y_range_cpu(i * rows_per_thread, (i + 1) * rows_per_thread, config);
+				}
+				else {
+					precompute_factored_temperatures_for_range_cpu(i * timesteps_per_thread,
+						(i + 1) * timesteps_per_thread, i * rows_per_thread, (i + 1) * rows_per_thread, config);
+				}
 			}
 		));
 	}
@@ -95,11 +506,13 @@ void GeneticSimulation::Planet::precompute_temperatures_cpu(unsigned int worker_
 	}
 }
 
-// precompute temperatures on the CPU for the given timestep range
-void GeneticSimulation::Planet::precompute_temperatures_for_timestep_range_cpu(unsigned int start_t, unsigned int end_t, const Config& config)
+// precompute temperatures on the CPU for the given timestep and y ranges
+void GeneticSimulation::Planet::precompute_temperatures_for_range_cpu(unsigned int start_t, unsigned int end_t,
+	unsigned int start_y, unsigned int end_y, const Config& config)
 {
-	// cap end_t
+	// cap end_t and end_y
 	end_t = min(end_t, config.orbital_period);
+	end_y = min(end_y, config.area_height);
 
 	// initialize vector for storing intermediate equatorial temperature results
 	vector<double> equatorial_black_body_temperatures(end_t - start_t);
@@ -140,7 +553,7 @@ void GeneticSimulation::Planet::precompute_temperatures_for_timestep_range_cpu(u
 		extra_logitude, daylight_proportion, radiation_strength, base_temperature, moderated_temperature;
 
 	// calculate final temperatures based on timestep (angle in orbit) and y position (latitude)
-	for (unsigned int y = 0; y < config.area_height; y++)
+	for (unsigned int y = start_y; y < end_y; y++)
 	{
 		// calculate latitude corresponding to y coordinate
 		latitude = -(((static_cast<double>(y) / static_cast<double>(config.area_height - 1))
@@ -188,10 +601,122 @@ void GeneticSimulation::Planet::precompute_temperatures_for_timestep_range_cpu(u
 					* config.temperature_moderation_bias);
 
 			// calculate final temperature which accounts for greenhouse effect
-			temperatures[y * config.orbital_period + t] = moderated_temperature
-				* pow((1 + 0.75 * config.atmosphere_optical_thickness), 0.25);
+			store_temperature(static_cast<size_t>(y) * config.orbital_period + t, moderated_temperature
+				* pow((1 + 0.75 * config.atmosphere_optical_thickness), 0.25));
+		}
+	}
+}
+
+// precompute temperatures on the CPU for the given timestep and y ranges using a vectorized kernel with 
+// terms depending only on latitude or timestep (given for the whole orbit) hoisted out of the loop
+void GeneticSimulation::Planet::precompute_temperatures_for_range_vectorized(unsigned int start_t, unsigned int end_t,
+	unsigned int start_y, unsigned int end_y, const TimestepTerms& timestep_terms, const Config& config)
+{
+	// cap end_t and end_y
+	end_t = min(end_t, config.orbital_period);
+	end_y = min(end_y, config.area_height);
+	if (start_t >= end_t) return;
+	unsigned int range = end_t - start_t;
+
+	TemperatureModel model(config);
+
+	// calculate temperatures for each latitude, directly into full lookup table or via a row to quantize
+	vector<float> row(storage == full_storage ? 0 : range);
+	for (unsigned int y = start_y; y < end_y; y++) {
+		size_t row_start = static_cast<size_t>(y) * config.orbital_period + start_t;
+		float* row_temperatures = storage == full_storage ? &temperatures[row_start] : row.data();
+		compute_temperature_row(model.get_latitude_terms(y), &timestep_terms.equatorial_temperatures[start_t],
+			&timestep_terms.tan_tilts[start_t], &timestep_terms.cos_tilts[start_t], &timestep_terms.sin_tilts[start_t],
+			range, model.get_moderation_slope(),
+			model.get_moderation_intercept(), row_temperatures);
+		if (storage != full_storage) {
+			for (unsigned int i = 0; i < range; i++) {
+				store_temperature(row_start + i, row[i]);
+			}
+		}
+	}
+}
+
+// precompute factored temperature tables on the CPU for the given timestep and y ranges
+void GeneticSimulation::Planet::precompute_factored_temperatures_for_range_cpu(unsigned int start_t, 
+	unsigned int end_t, unsigned int start_y, unsigned int end_y, const Config& config)
+{
+	// cap end_t and end_y
+	end_t = min(end_t, config.orbital_period);
+	end_y = min(end_y, config.area_height);
+
+	TemperatureModel model(config);
+
+	// calculate equatorial temperature and position of effective axial tilt between sampled tilts
+	// (evenly spaced from -axial_tilt to axial_tilt) for each timestep
+	for (unsigned int t = start_t; t < end_t; t++) {
+		equatorial_temperatures[t] = static_cast<float>(model.get_equatorial_temperature(t));
+		tilt_positions[t] = tilt_samples == 1 ? 0.f : static_cast<float>(min(tilt_samples - 1.0,
+			max(0.0, (model.get_effective_axial_tilt(t) / config.axial_tilt + 1) / 2 * (tilt_samples - 1))));
+	}
+
+	// calculate surface factor for each y coordinate at each sampled tilt, repeating the last
+	for (unsigned int y = start_y; y < end_y; y++) {
+		auto latitude = model.get_latitude(y);
+		auto factors = &surface_factors[static_cast<size_t>(y) * surface_factors_per_y];
+		for (unsigned int i = 0; i < tilt_samples; i++) {
+			auto tilt = tilt_samples == 1 ? 0.0 : config.axial_tilt * (2.0 * i / (tilt_samples - 1) - 1);
+			factors[i] = static_cast<float>(model.get_surface_factor(latitude, tilt));
 		}
+		factors[tilt_samples] = factors[tilt_samples - 1];
+	}
+}
+
+// precompute sampled temperatures on the CPU for the given y range
+void GeneticSimulation::Planet::precompute_sampled_temperatures_for_y_range_cpu(unsigned int start_y, 
+	unsigned int end_y, const Config& config)
+{
+	// cap end_y
+	end_y = min(end_y, config.area_height);
+	if (start_y >= end_y) return;
+
+	TemperatureModel model(config);
+
+	// calculate terms depending only on timestep for each sample (the model is periodic over the
+	// orbit, so the sample before the first timestep is taken one stride before the end of the orbit)
+	vector<float> sample_equatorial_temperatures(samples_per_y), tan_tilts(samples_per_y), 
+		cos_tilts(samples_per_y), sin_tilts(samples_per_y);
+	for (unsigned int i = 0; i < samples_per_y; i++) {
+		unsigned int t = i == 0 ? config.orbital_period - temperature_stride : (i - 1) * temperature_stride;
+		sample_equatorial_temperatures[i] = static_cast<float>(model.get_equatorial_temperature(t));
+		model.get_tilt_terms(t, tan_tilts[i], cos_tilts[i], sin_tilts[i]);
+	}
+
+	// calculate samples for each latitude
+	for (unsigned int y = start_y; y < end_y; y++) {
+		compute_temperature_row(model.get_latitude_terms(y), sample_equatorial_temperatures.data(), 
+			tan_tilts.data(), cos_tilts.data(), sin_tilts.data(), samples_per_y, model.get_moderation_slope(),
+			model.get_moderation_intercept(), &sampled_temperatures[static_cast<size_t>(y) * samples_per_y]);
+	}
+}
+
+// report error of sampled temperatures against the model at full resolution
+void GeneticSimulation::Planet::report_sampled_temperature_error(const Config& config) const
+{
+	TemperatureModel model(config);
+
+	// compare against the model at randomly chosen latitudes and timesteps
+	const unsigned int error_samples = 65536;
+	std::default_random_engine rng(1);
+	std::uniform_int_distribution<unsigned int> y_distribution(0, config.area_height - 1);
+	std::uniform_int_distribution<unsigned int> t_distribution(0, config.orbital_period - 1);
+	double max_error = 0, sum_squared_error = 0;
+	for (unsigned int i = 0; i < error_samples; i++) {
+		auto y = y_distribution(rng);
+		auto t = t_distribution(rng);
+		double error = std::abs(get_temperature(y, t) - model.get_temperature(y, t));
+		max_error = max(max_error, error);
+		sum_squared_error += error * error;
 	}
+	cout << "Sampled temperatures every " << temperature_stride << " timesteps with " 
+		<< (interpolation == linear_interpolation ? "linear" : "cubic") << " interpolation: max error "
+		<< fixed << setprecision(5) << max_error << " K, RMS error " << std::sqrt(sum_squared_error / error_samples) 
+		<< " K\n" << std::defaultfloat << setprecision(6);
 }
 
 #ifdef GPU_SUPPORT
@@ -331,7 +856,7 @@ void GeneticSimulation::Planet::benchmark_temperature_computation_cpu(unsigned i
 	// allocate space to store results
 	vector<unsigned long long> times(config.planet_benchmark_samples);
 
-	// precompute temperatures and record results
+	// precompute temperatures with selected storage, kernel and backend and record results
 	for (unsigned int i = 0; i < config.planet_benchmark_samples; i++) {
 		start = steady_clock::now();
 		precompute_temperatures_cpu(worker_threads, config);
@@ -345,6 +870,163 @@ void GeneticSimulation::Planet::benchmark_temperature_computation_cpu(unsigned i
 	write_benchmark_results(times, header, filename, config.results_path);
 }
 
+// compare precomputing with each storage, and for full storage each kernel and backend, against a 
+// double-precision reference, reporting memory used, mean precompute time and throughput, speedup
+// over and maximum difference from the scalar kernel, maximum and RMS error and lookup cost
+void GeneticSimulation::Planet::evaluate_temperature_variants(unsigned int worker_threads, const Config& config)
+{
+	// variants to evaluate: full storage with scalar kernel and with vectorized kernel on each available
+	// backend, then each other storage with the selected kernel and backend
+	struct Variant {
+		string name;
+		temperature_storage storage;
+		bool vectorized;
+		compute_backend backend;
+	};
+	vector<Variant> variants;
+	variants.push_back({ "full_scalar", full_storage, false, backend });
+	for (unsigned int b = 0; b < num_compute_backends; b++) {
+		auto variant_backend = static_cast<compute_backend>(b);
+		if (get_compute_backend_available(variant_backend)) {
+			variants.push_back({ string("full_vectorized_") + get_compute_backend_name(variant_backend), 
+				full_storage, true, variant_backend });
+		}
+	}
+	for (unsigned int s = 0; s < num_temperature_storages; s++) {
+		if (s != full_storage) {
+			auto variant_storage = static_cast<temperature_storage>(s);
+			variants.push_back({ get_temperature_storage_name(variant_storage), variant_storage, vectorized, backend });
+		}
+	}
+
+	// compute double-precision reference at every timestep for evenly spaced y coordinates, 
+	// limited to about 16M values (every y coordinate unless the orbit is long or the area tall)
+	TemperatureModel model(config);
+	size_t cells = static_cast<size_t>(config.area_height) * config.orbital_period;
+	unsigned int reference_y_stride = static_cast<unsigned int>((cells + (1 << 24) - 1) >> 24);
+	unsigned int reference_rows = (config.area_height + reference_y_stride - 1) / reference_y_stride;
+	vector<double> reference(static_cast<size_t>(reference_rows) * config.orbital_period);
+	parallel_for_tiles(threads_backend, worker_threads, reference_rows, config.orbital_period,
+		reference_rows / worker_threads + 1, config.orbital_period,
+		[&](unsigned int start_row, unsigned int end_row, unsigned int, unsigned int) {
+			for (unsigned int row = start_row; row < end_row; row++) {
+				for (unsigned int t = 0; t < config.orbital_period; t++) {
+					reference[static_cast<size_t>(row) * config.orbital_period + t] = 
+						model.get_temperature(row * reference_y_stride, t);
+				}
+			}
+		});
+
+	// latitudes of organisms looked up in each timestep, as in reacting to temperature
+	std::default_random_engine rng(1);
+	std::uniform_int_distribution<unsigned int> y_distribution(5, config.area_height - 6);
+	vector<unsigned int> lookup_ys(config.population_size);
+	for (auto& y : lookup_ys) {
+		y = y_distribution(rng);
+	}
+	const unsigned int lookup_timesteps = 1000;
+
+	// output name of results file
+	namespace fs = boost::filesystem;
+	fs::path results_file_path(config.results_path);
+	results_file_path /= "planet_variants_cpu_" + to_string(worker_threads) + "_threads.csv";
+	cout << "Writing temperature variant results to " << results_file_path.string() << "\n";
+	fs::ofstream results_file(results_file_path, ios::trunc);
+	if (!results_file) {
+		cerr << "Writing results file failed: Check that the path exists and may be written to\n";
+	}
+	results_file << "variant,memory_bytes,precompute_microseconds,cells_per_second,speedup_over_full_scalar,"
+		"max_difference_from_full_scalar_kelvin,max_error_kelvin,rms_error_kelvin,lookup_nanoseconds\n";
+	cout << "Precompute times are means of " << config.planet_benchmark_samples << " samples, and speedups and "
+		"differences are against full_scalar\n";
+	cout << "Errors are against double precision at every timestep for every " 
+		<< (reference_y_stride == 1 ? "" : to_string(reference_y_stride) + " ") << "y coordinate\n";
+	cout << left << setw(26) << "variant" << right << setw(14) << "memory (MiB)" << setw(16) << "precompute (ms)"
+		<< setw(14) << "Mcells/s" << setw(10) << "speedup" << setw(16) << "max diff (K)" << setw(16) << "max error (K)"
+		<< setw(16) << "RMS error (K)" << setw(14) << "lookup (ns)" << "\n";
+
+	// temperatures of full_scalar at the reference points and its mean precompute time, which the
+	// other variants are compared against
+	vector<float> scalar_temperatures(reference.size());
+	double scalar_precompute_time = 0;
+
+	for (auto& v : variants) {
+		bool scalar_variant = &v == &variants.front();
+
+		// precompute temperatures with variant for each sample, counting any time waiting for
+		// temperatures computed in the background as precompute time, and in the last sample measure
+		// maximum and RMS error against reference and maximum difference from full_scalar
+		std::unique_ptr<Planet> variant;
+		double precompute_time = 0;
+		double max_error = 0, sum_squared_error = 0, max_difference = 0;
+		for (unsigned int i = 0; i < config.planet_benchmark_samples; i++) {
+			bool last_sample = i + 1 == config.planet_benchmark_samples;
+			// release previous sample's temperatures before allocating the next
+			variant.reset();
+			variant = std::make_unique<Planet>();
+			auto start = steady_clock::now();
+			variant->allocate_temperatures(config, v.storage);
+			variant->vectorized = v.vectorized;
+			variant->backend = v.backend;
+			variant->precompute_temperatures_cpu(worker_threads, config);
+			auto precompute_duration = steady_clock::now() - start;
+			variant->initialized = true;
+			for (unsigned int t = 0; t < config.orbital_period; t++) {
+				start = steady_clock::now();
+				variant->wait_for_timestep(t);
+				precompute_duration += steady_clock::now() - start;
+				if (!last_sample) continue;
+				for (unsigned int row = 0; row < reference_rows; row++) {
+					auto point = static_cast<size_t>(row) * config.orbital_period + t;
+					auto temperature = variant->get_temperature(row * reference_y_stride, t);
+					if (scalar_variant) scalar_temperatures[point] = temperature;
+					double error = std::abs(temperature - reference[point]);
+					max_error = max(max_error, error);
+					sum_squared_error += error * error;
+					max_difference = max(max_difference, static_cast<double>(std::abs(temperature - scalar_temperatures[point])));
+				}
+			}
+			precompute_time += static_cast<double>(duration_cast<microseconds>(precompute_duration).count()) /
+				config.planet_benchmark_samples;
+		}
+		if (scalar_variant) scalar_precompute_time = precompute_time;
+		double speedup = scalar_precompute_time / max(1.0, precompute_time);
+		double rms_error = std::sqrt(sum_squared_error / (static_cast<double>(reference_rows) * config.orbital_period));
+		double cells_per_second = cells / max(1e-6, precompute_time / 1e6);
+
+		// measure memory used
+		MemoryFootprint footprint;
+		variant->add_memory_usage(footprint);
+
+		// measure mean time per lookup at, north of and south of each organism's latitude for a run 
+		// of consecutive timesteps in the second orbit, excluding any time waiting for temperatures
+		float sum = 0;
+		steady_clock::duration lookup_duration(0);
+		for (unsigned int i = 0; i < lookup_timesteps; i++) {
+			unsigned int t = config.orbital_period + i;
+			variant->wait_for_timestep(t);
+			auto start = steady_clock::now();
+			for (auto y : lookup_ys) {
+				sum += variant->get_temperature(y, t) + variant->get_temperature(y - 5, t) + variant->get_temperature(y + 5, t);
+			}
+			lookup_duration += steady_clock::now() - start;
+		}
+		lookup_sink = sum;
+		double lookup_time = duration_cast<std::chrono::nanoseconds>(lookup_duration).count() /
+			(3.0 * lookup_timesteps * lookup_ys.size());
+
+		// report results
+		cout << left << setw(26) << v.name << right << fixed << setprecision(3)
+			<< setw(14) << footprint.get_total() / (1024.0 * 1024.0) << setw(16) << precompute_time / 1000.0
+			<< setw(14) << setprecision(1) << cells_per_second / 1e6 << setw(9) << setprecision(2) << speedup << "x"
+			<< setw(16) << setprecision(5) << max_difference << setw(16) << max_error << setw(16) << rms_error 
+			<< setw(14) << setprecision(2) << lookup_time << "\n" << std::defaultfloat << setprecision(6);
+		results_file << v.name << "," << footprint.get_total() << "," << precompute_time << "," 
+			<< cells_per_second << "," << speedup << "," << max_difference << "," << max_error << "," 
+			<< rms_error << "," << lookup_time << "\n";
+	}
+}
+
 #ifdef GPU_SUPPORT
 // benchmark precomputation on the GPU
 void GeneticSimulation::Planet::benchmark_temperature_computation_gpu(const Config& config)
@@ -2,11 +2,49 @@
 
 #include "helper/platform.h"
 #include "Config.h"
+#include "TemperatureStorage.h"
+#include "TemperatureKernel.h"
+#include "ComputeBackend.h"
+#include "helper/MemoryFootprint.h"
 #include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
 
 namespace GeneticSimulation
 {
-	// precomputes and stores planetary surface temperature
+	class TemperatureCache;
+	class TemperatureSharedMemory;
+	class Planet;
+
+	// temperatures for every y coordinate at the two latest timesteps requested by one simulation, which
+	// the first caller at each timestep publishes from the planet for all of the simulation's threads
+	// (kept outside the planet so that simulations at different timesteps may share one planet)
+	class TemperatureRows
+	{
+	public:
+
+		// constructor which takes the number of y coordinates
+		explicit TemperatureRows(unsigned int height);
+
+	private:
+
+		friend class Planet;
+
+		// temperatures for every y coordinate at each of the two timesteps
+		std::vector<float> rows;
+		// timestep published to each row
+		std::atomic<unsigned int> timesteps[2];
+		// mutex for publishing
+		std::mutex mx;
+	};
+
+	// precomputes and stores planetary surface temperature, which once precomputed is only read
+	// (apart from windowed storage) and so may be shared by simulations in the same process
 	class Planet
 	{
 	public:
@@ -14,20 +52,89 @@ namespace GeneticSimulation
 		// default constructor
 		Planet();
 
+		// destructor which stops computing temperatures in the background
+		~Planet();
+
 		// precompute temperatures
 		void precompute_temperatures(const Config& config, bool benchmark = false);
 
 		// get temperature from lookup table
 		float get_temperature(unsigned int y, unsigned int t) const;
 
+		// get temperatures for every y coordinate at a timestep, so that all lookups in a timestep read
+		// one small array (for windowed storage this is the window slot after waiting for it, otherwise
+		// the first caller at each timestep publishes a row into the given rows shared by all threads,
+		// which remains valid until the timestep after next is requested)
+		const float* get_temperature_row(unsigned int t, TemperatureRows& rows) const;
+
+		// get whether temperatures are computed in the background as timesteps are reached, so that
+		// the planet follows a single simulation and cannot be shared
+		bool get_windowed() const { return storage == windowed_storage; }
+
+		// wait until temperatures for a timestep are available, and allow temperatures for timesteps
+		// before the previous one to be evicted (only has an effect for windowed storage, where
+		// timesteps must be waited for in increasing order)
+		void wait_for_timestep(unsigned int t) const {
+			if (storage == windowed_storage) wait_for_window_timestep(t);
+		}
+
+		// continue from the given timestep instead of the first, such as after restoring a checkpoint
+		// (only has an effect for windowed storage, which restarts computing ahead from this timestep)
+		void start_at_timestep(unsigned int t, const Config& config);
+
+		// add memory used by temperature lookup table to a footprint
+		void add_memory_usage(MemoryFootprint& footprint) const;
+
 	private:
 
+		// set up lookup tables for the given storage
+		void allocate_temperatures(const Config& config, temperature_storage selected_storage);
+
 		// precompute temperatures on the CPU
 		void precompute_temperatures_cpu(unsigned int worker_threads, const Config& config);
 
-		// precompute temperatures on the CPU for the given timestep range
-		void precompute_temperatures_for_timestep_range_cpu(unsigned int start_t, 
-			unsigned int end_t, const Config& config);
+		// precompute factored temperature tables on the CPU for the given timestep and y ranges
+		void precompute_factored_temperatures_for_range_cpu(unsigned int start_t, unsigned int end_t,
+			unsigned int start_y, unsigned int end_y, const Config& config);
+
+		// precompute sampled temperatures on the CPU for the given y range
+		void precompute_sampled_temperatures_for_y_range_cpu(unsigned int start_y, unsigned int end_y,
+			const Config& config);
+
+		// report error of sampled temperatures against the model at full resolution
+		void report_sampled_temperature_error(const Config& config) const;
+
+		// store a precomputed temperature in the full or quantized lookup table
+		inline void store_temperature(std::size_t i, double temperature);
+
+		// start computing temperatures for upcoming timesteps from the given timestep in the background
+		void start_window_thread(const Config& config, unsigned int start_timestep = 0);
+
+		// stop computing temperatures in the background
+		void stop_window_thread();
+
+		// map full or quantized lookup table from cache, returning whether successful
+		bool map_temperature_cache(const Config& config);
+
+		// attach to full or quantized lookup table published in shared memory by another process,
+		// returning whether successful (if not, the table is published after precomputing it)
+		bool attach_shared_temperatures(const Config& config);
+
+		// publish full or quantized lookup table in shared memory and read it from there instead
+		void publish_shared_temperatures();
+
+		// wait until temperatures for a timestep have been computed in the background
+		void wait_for_window_timestep(unsigned int t) const;
+
+		// precompute temperatures on the CPU for the given timestep and y ranges
+		void precompute_temperatures_for_range_cpu(unsigned int start_t, unsigned int end_t,
+			unsigned int start_y, unsigned int end_y, const Config& config);
+
+		// precompute temperatures on the CPU for the given timestep and y ranges using a vectorized 
+		// kernel with terms depending only on latitude or timestep (given for the whole orbit) hoisted
+		// out of the loop
+		void precompute_temperatures_for_range_vectorized(unsigned int start_t, unsigned int end_t,
+			unsigned int start_y, unsigned int end_y, const TimestepTerms& timestep_terms, const Config& config);
 
 #ifdef GPU_SUPPORT
 		// precompute temperatures on the GPU
@@ -37,6 +144,11 @@ namespace GeneticSimulation
 		// benchmark precomputation on the CPU
 		void benchmark_temperature_computation_cpu(unsigned int worker_threads, const Config& config);
 
+		// compare precomputing with each storage, and for full storage each kernel and backend, against a 
+		// double-precision reference, reporting memory used, precompute time and throughput, maximum and 
+		// RMS error and lookup cost
+		void evaluate_temperature_variants(unsigned int worker_threads, const Config& config);
+
 #ifdef GPU_SUPPORT
 		// benchmark precomputation on the GPU
 		void benchmark_temperature_computation_gpu(const Config& config);
@@ -44,8 +156,57 @@ namespace GeneticSimulation
 
 		// whether temperatures have been precomputed
 		bool initialized;
-		// lookup table for temperature
+		// how temperatures are stored
+		temperature_storage storage;
+		// whether full or quantized temperatures are precomputed with the vectorized kernel
+		bool vectorized;
+		// how precomputing full or quantized temperatures is parallelized
+		compute_backend backend;
+		// lookup table for temperature (full storage)
 		std::vector<float> temperatures;
+		// lookup table for quantized temperature, and offset and scale 
+		// for converting to temperature (quantized storage)
+		std::vector<uint16_t> temperatures_quantized;
+		// full or quantized lookup table to read, either in the vectors above or in a mapped cache file
+		const float* temperatures_data;
+		const uint16_t* temperatures_quantized_data;
+		// cache of full or quantized lookup table (null if disabled)
+		std::unique_ptr<TemperatureCache> temperature_cache;
+		// full or quantized lookup table shared with other processes (null if disabled)
+		std::unique_ptr<TemperatureSharedMemory> temperature_shared;
+		double quantization_offset;
+		double quantization_scale;
+		// equatorial temperature and position between sampled axial tilts for each timestep, and
+		// surface factor for each y coordinate at each sampled axial tilt (factored storage)
+		std::vector<float> equatorial_temperatures;
+		std::vector<float> tilt_positions;
+		std::vector<float> surface_factors;
+		// number of sampled axial tilts, and number of surface factors per y coordinate
+		// (one more than sampled tilts so interpolation never needs to check bounds)
+		unsigned int tilt_samples;
+		unsigned int surface_factors_per_y;
+		// temperatures for each y coordinate every stride timesteps, where sample i is at timestep 
+		// (i - 1) * stride so that there is one before the first timestep and two after the last 
+		// (sampled storage)
+		std::vector<float> sampled_temperatures;
+		unsigned int temperature_stride;
+		unsigned int samples_per_y;
+		temperature_interpolation interpolation;
+		// temperatures for each y coordinate for a window of timesteps, stored time-major in a ring
+		// so that timestep t is at slot t % window_timesteps (windowed storage)
+		std::vector<float> window_temperatures;
+		unsigned int window_timesteps;
+		unsigned int area_height;
+		// thread computing windowed temperatures ahead of the latest timestep waited for
+		std::thread window_thread;
+		// number of timesteps computed, latest timestep waited for, and whether to stop computing
+		mutable std::atomic<unsigned int> window_computed;
+		mutable std::atomic<unsigned int> window_current;
+		std::atomic<bool> window_stop;
+		// mutex and condition variables for waking the window thread and threads waiting for it
+		mutable std::mutex window_mutex;
+		mutable std::condition_variable window_advanced;
+		mutable std::condition_variable window_computed_advanced;
 		// number of timesteps in orbital period, used 
 		// for calculating indexes in lookup table
 		unsigned int timesteps;
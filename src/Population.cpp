@@ -10,6 +10,7 @@ using std::uniform_real_distribution;
 using std::normal_distribution;
 using std::min;
 using std::max;
+using std::memory_order_relaxed;
 
 using namespace GeneticSimulation;
 
@@ -18,8 +19,10 @@ GeneticSimulation::Population::Population(SimulationArea& area, const Planet& pl
 	ConsumableResourcePool& food, ConsumableResourcePool& water, const Config& config) :
 	// initialize base class object
 	SimulationObjectPool(config.population_size),
-	// initialize references to area, planet, food, water and config
-	area(area), planet(planet), food(food), water(water), config(config) {}
+	// initialize references to area, planet, food, water and config, and rows for every y coordinate
+	area(area), planet(planet), temperature_rows(config.area_height), food(food), water(water), config(config),
+	// initialize phylogeny for every slot
+	phylogeny(config.population_size) {}
 
 // initialize the population with a number of organisms
 void GeneticSimulation::Population::init_random(unsigned int n, default_random_engine& rng)
@@ -39,29 +42,58 @@ void GeneticSimulation::Population::init_random(unsigned int n, default_random_e
 	for (unsigned int i = 0; i < get_max_size(); i++) {
 		// add a new uninitialized organism
 		add_item(i, area, config);
-		// either initialize organism or set index as available
-		i < n ? at(i).init(sf::Vector2f(dist_x(rng), dist_y(rng)), config, rng) : 
+		// either initialize organism as a founder of the phylogeny or set index as available
+		if (i < n) {
+			at(i).init(next_id.fetch_add(1, memory_order_relaxed),
+				sf::Vector2f(dist_x(rng), dist_y(rng)), config, rng);
+			phylogeny.add_founder(i, at(i).get_id(), 0);
+		}
+		else {
 			set_available(i);
+		}
 	}
 
+	// record initial population
+	counters.alive.store(n, memory_order_relaxed);
+
 	// record initialization
 	set_initialized(true);
 }
 
-// let organisms in given range interact with nearby organisms
-void GeneticSimulation::Population::interact(unsigned int start, unsigned int end, default_random_engine& rng)
+// let organisms in given range interact with nearby organisms, returning number of pair tests
+// (recording gene transfers in the thread's lineage log if given)
+unsigned long long GeneticSimulation::Population::interact(unsigned int start, unsigned int end, default_random_engine& rng,
+	LineageThreadLog* lineage)
 {
-	if (!get_initialized()) return;
+	if (!get_initialized()) return 0;
 
 	end = min(get_max_size(), end);
 
+	// number of gene transfers and pair tests between living organisms in range
+	unsigned long long transfers = 0;
+	unsigned long long pair_tests = 0;
+	// weighting of other organism's genes in a transfer
+	float weighting;
+
 	for (unsigned int i = start; i < end; i++) {
+		// dead organisms do not interact
+		if (!at(i).get_exists()) continue;
 		for (unsigned int j = 0; j < get_max_size(); j++) {
 			if (i != j) {
-				at(i).interact_with(at(j), rng);
+				pair_tests += at(j).get_exists();
+				if (at(i).interact_with(at(j), rng, weighting)) {
+					transfers++;
+					// record transfer from donor to recipient
+					if (lineage) lineage->record(gene_transfer_event, i, at(i).get_id(), at(j).get_id(), weighting);
+				}
 			}
 		}
 	}
+
+	// add gene transfers to running total
+	counters.gene_transfers.fetch_add(transfers, memory_order_relaxed);
+
+	return pair_tests;
 }
 
 // let organisms in given range react to surrounding temperature
@@ -71,27 +103,40 @@ void GeneticSimulation::Population::react_to_temperature(unsigned int start, uns
 
 	end = min(get_max_size(), end);
 
+	// get temperatures for every y coordinate at this timestep (waiting for them 
+	// if computed in the background), shared by all organisms and threads
+	auto temperatures = get_temperature_row(time);
+
 	for (unsigned int i = start; i < end; i++) {
-		at(i).react_to_temperature(planet, time);
+		at(i).react_to_temperature(temperatures);
 	}
 }
 
-// nourish organisms with given range of items in food pool
-void GeneticSimulation::Population::nourish(unsigned int pool_start, 
+// get temperatures for every y coordinate at a timestep (waiting for them if computed in the
+// background), which remain valid until the timestep after next is requested
+const float* GeneticSimulation::Population::get_temperature_row(unsigned int time)
+{
+	return planet.get_temperature_row(time, temperature_rows);
+}
+
+// nourish organisms with given range of items in food pool, returning number of range checks
+unsigned long long GeneticSimulation::Population::nourish(unsigned int pool_start, 
 	unsigned int pool_end, default_random_engine& rng)
 {
-	distribute_resources(pool_start, pool_end, food_pool, rng);
+	return distribute_resources(pool_start, pool_end, food_pool, rng);
 }
 
-// hydrate organisms with given range of items in water pool
-void GeneticSimulation::Population::hydrate(unsigned int pool_start, 
+// hydrate organisms with given range of items in water pool, returning number of range checks
+unsigned long long GeneticSimulation::Population::hydrate(unsigned int pool_start, 
 	unsigned int pool_end, default_random_engine& rng)
 {
-	distribute_resources(pool_start, pool_end, water_pool, rng);
+	return distribute_resources(pool_start, pool_end, water_pool, rng);
 }
 
-// let organisms in given range potentially replicate themselves
-void GeneticSimulation::Population::replicate(unsigned int start, unsigned int end, default_random_engine& rng)
+// let organisms in given range potentially replicate themselves at the given timestep
+// (recording births in the thread's lineage log if given)
+void GeneticSimulation::Population::replicate(unsigned int start, unsigned int end, unsigned int time,
+	default_random_engine& rng, LineageThreadLog* lineage)
 {
 	if (!get_initialized()) return;
 
@@ -101,6 +146,8 @@ void GeneticSimulation::Population::replicate(unsigned int start, unsigned int e
 	uniform_real_distribution<float> dist_replicate(0, 1);
 	// probability of replication for current organism
 	float replication_prob;
+	// number of births in range
+	unsigned long long births = 0;
 	// for each organism
 	for (unsigned int i = start; i < end; i++) {
 		// if organism exists
@@ -113,15 +160,23 @@ void GeneticSimulation::Population::replicate(unsigned int start, unsigned int e
 				if (!get_available_slot(
 					[&, i](unsigned int slot) {
 						// initialize child from parent
-						at(slot).init_from(at(i), config, rng);
+						at(slot).init_from(next_id.fetch_add(1, memory_order_relaxed), at(i), config, rng);
 						// set parent and child as colliding
 						at(i).set_collision(slot);
 						at(slot).set_collision(i);
+						// record birth
+						births++;
+						phylogeny.add_birth(slot, at(slot).get_id(), i, time);
+						if (lineage) lineage->record(birth_event, slot, at(slot).get_id(), at(i).get_id(), 1.f);
 					}
 				)) break;
 			}
 		}
 	}
+
+	// add births to running totals
+	counters.births.fetch_add(births, memory_order_relaxed);
+	counters.alive.fetch_add(births, memory_order_relaxed);
 }
 
 // update phenotypes of each organism in given range if necessary
@@ -136,44 +191,67 @@ void GeneticSimulation::Population::update_phenotypes(unsigned int start, unsign
 	}
 }
 
-// update fitness of each organism in given range
-void Population::update_fitness(unsigned int start, unsigned int end)
+// update fitness of each organism in given range, returning number of live organisms processed
+// (recording deaths in the thread's lineage log if given)
+unsigned long long Population::update_fitness(unsigned int start, unsigned int end, LineageThreadLog* lineage)
 {
-	if (!get_initialized()) return;
+	if (!get_initialized()) return 0;
 
 	end = min(get_max_size(), end);
 
+	// number of live organisms processed and deaths in range
+	unsigned long long processed = 0;
+	unsigned long long deaths = 0;
+
 	for (unsigned int i = start; i < end; i++) {
-		// if not already dead but died this time step
-		if (at(i).get_exists() && !at(i).update_fitness()) {
-			// add index to available slots
-			set_available(i);
+		// if not already dead
+		if (at(i).get_exists()) {
+			processed++;
+			// if died this time step
+			if (!at(i).update_fitness()) {
+				// add index to available slots
+				set_available(i);
+				// record death
+				deaths++;
+				phylogeny.remove_death(i);
+				if (lineage) lineage->record(death_event, i, at(i).get_id(), 0, 0.f);
+			}
 		}
 	}
+
+	// add deaths to running totals
+	counters.deaths.fetch_add(deaths, memory_order_relaxed);
+	counters.alive.fetch_sub(deaths, memory_order_relaxed);
+
+	return processed;
 }
 
-// let organisms in given range determine heading to nearest food
-void GeneticSimulation::Population::search_for_food(unsigned int start, unsigned int end)
+// let organisms in given range determine heading to nearest food, returning number of items scanned
+unsigned long long GeneticSimulation::Population::search_for_food(unsigned int start, unsigned int end)
 {
-	if (!get_initialized()) return;
+	if (!get_initialized()) return 0;
 
 	end = min(get_max_size(), end);
 
+	unsigned long long scanned = 0;
 	for (unsigned int i = start; i < end; i++) {
-		at(i).search_for_food(food);
+		scanned += at(i).search_for_food(food);
 	}
+	return scanned;
 }
 
-// let organisms in given range determine heading to nearest water
-void GeneticSimulation::Population::search_for_water(unsigned int start, unsigned int end)
+// let organisms in given range determine heading to nearest water, returning number of items scanned
+unsigned long long GeneticSimulation::Population::search_for_water(unsigned int start, unsigned int end)
 {
-	if (!get_initialized()) return;
+	if (!get_initialized()) return 0;
 
 	end = min(get_max_size(), end);
 
+	unsigned long long scanned = 0;
 	for (unsigned int i = start; i < end; i++) {
-		at(i).search_for_water(water);
+		scanned += at(i).search_for_water(water);
 	}
+	return scanned;
 }
 
 // let organisms in given range decide on action based on sensory data
@@ -212,22 +290,103 @@ void GeneticSimulation::Population::update_sprites(unsigned int start, unsigned
 	}
 }
 
-// distribute resources in given range of resource pool to organisms
-void GeneticSimulation::Population::distribute_resources(unsigned int pool_start, 
+// get running totals of population events
+const PopulationCounters& GeneticSimulation::Population::get_counters() const
+{
+	return counters;
+}
+
+// get tree of descent of live organisms
+const Phylogeny& GeneticSimulation::Population::get_phylogeny() const
+{
+	return phylogeny;
+}
+
+// summarize fitness and physical traits of live organisms (should only be called
+// while no simulation thread is updating existence, fitness or phenotypes)
+GeneticSimulation::PopulationSummary GeneticSimulation::Population::summarize() const
+{
+	PopulationSummary summary;
+	for (unsigned int i = 0; i < get_max_size(); i++) {
+		auto& organism = at(i);
+		if (!organism.get_exists()) continue;
+		auto& phenotype = organism.get_phenotype();
+		summary.alive++;
+		summary.mean_fitness += organism.get_fitness();
+		summary.mean_area_of_influence += phenotype.get_area_of_influence();
+		summary.mean_speed += phenotype.get_speed();
+		summary.mean_health_rate += phenotype.get_health_rate();
+		summary.mean_ideal_temp += phenotype.get_ideal_temp();
+		summary.mean_temp_range += phenotype.get_temp_range();
+	}
+	// convert sums to means (leaving them at 0 if the population has died out)
+	if (summary.alive > 0) {
+		for (auto mean : { &summary.mean_fitness, &summary.mean_area_of_influence, &summary.mean_speed,
+			&summary.mean_health_rate, &summary.mean_ideal_temp, &summary.mean_temp_range }) {
+			*mean /= summary.alive;
+		}
+	}
+	return summary;
+}
+
+// add memory used by organisms and their components to a footprint
+void GeneticSimulation::Population::add_memory_usage(MemoryFootprint& footprint)
+{
+	SimulationObjectPool::add_memory_usage(footprint, "population");
+	phylogeny.add_memory_usage(footprint);
+	for (unsigned int i = 0; i < get_max_size(); i++) {
+		at(i).add_memory_usage(footprint);
+	}
+}
+
+// write organisms, available slots, running totals, next organism id and phylogeny to a checkpoint
+void GeneticSimulation::Population::write_checkpoint(CheckpointWriter& writer)
+{
+	SimulationObjectPool::write_checkpoint(writer);
+	for (auto counter : { &counters.births, &counters.deaths, &counters.gene_transfers,
+		&counters.food_consumed, &counters.water_consumed }) {
+		writer.write(counter->load(memory_order_relaxed));
+	}
+	writer.write(counters.alive.load(memory_order_relaxed));
+	writer.write(next_id.load(memory_order_relaxed));
+	phylogeny.write_checkpoint(writer);
+}
+
+// read organisms, available slots, running totals, next organism id and phylogeny from a checkpoint
+void GeneticSimulation::Population::read_checkpoint(CheckpointReader& reader)
+{
+	SimulationObjectPool::read_checkpoint(reader);
+	for (auto counter : { &counters.births, &counters.deaths, &counters.gene_transfers,
+		&counters.food_consumed, &counters.water_consumed }) {
+		counter->store(reader.read<unsigned long long>(), memory_order_relaxed);
+	}
+	counters.alive.store(reader.read<long long>(), memory_order_relaxed);
+	next_id.store(reader.read<uint64_t>(), memory_order_relaxed);
+	phylogeny.read_checkpoint(reader);
+}
+
+// distribute resources in given range of resource pool to organisms, returning number of range checks
+unsigned long long GeneticSimulation::Population::distribute_resources(unsigned int pool_start, 
 	unsigned int pool_end, resource_pool_type which_pool, default_random_engine& rng)
 {
 	// get reference to relevant pool
 	auto& pool = (which_pool == food_pool ? food : water);
 	// ensure end is valid
 	pool_end = min(pool.get_max_size(), pool_end);
+	// number of items consumed and range checks made
+	unsigned long long consumed = 0;
+	unsigned long long range_checks = 0;
 	// for each item
 	for (unsigned int i = pool_start; i < pool_end; i++) {
 		// if item exists
 		if (pool[i].get_exists()) {
 			// for each organism
 			for (unsigned int j = 0; j < get_max_size(); j++) {
-				// if organism is alive and in range to consume item
-				if (at(j).get_exists() && at(j).check_in_range(pool[i])) {
+				// skip organism if dead
+				if (!at(j).get_exists()) continue;
+				// if organism is in range to consume item
+				range_checks++;
+				if (at(j).check_in_range(pool[i])) {
 					// let organism consume item
 					if (which_pool == food_pool) {
 						at(j).nourish(pool.consume_and_reset_item(i, rng));
@@ -235,10 +394,18 @@ void GeneticSimulation::Population::distribute_resources(unsigned int pool_start
 					else {
 						at(j).hydrate(pool.consume_and_reset_item(i, rng));
 					}
+					// record consumption
+					consumed++;
 					// break as only one organism may consume item
 					break;
 				}
 			}
 		}
 	}
+
+	// add consumed items to running total
+	(which_pool == food_pool ? counters.food_consumed : counters.water_consumed)
+		.fetch_add(consumed, memory_order_relaxed);
+
+	return range_checks;
 }
\ No newline at end of file
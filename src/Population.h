@@ -5,10 +5,41 @@
 #include "Config.h"
 #include "engine/SimulationArea.h"
 #include "genetics/StandardizeParams.h"
+#include "LineageLog.h"
+#include "Phylogeny.h"
 #include <random>
+#include <atomic>
 
 namespace GeneticSimulation
 {
+	// running totals of population events, maintained atomically
+	// so that they may be read from any thread without locking
+	struct PopulationCounters
+	{
+		// number of organisms currently alive
+		std::atomic<long long> alive{ 0 };
+		// number of organisms born and died
+		std::atomic<unsigned long long> births{ 0 };
+		std::atomic<unsigned long long> deaths{ 0 };
+		// number of gene transfers between organisms
+		std::atomic<unsigned long long> gene_transfers{ 0 };
+		// number of food and water items consumed
+		std::atomic<unsigned long long> food_consumed{ 0 };
+		std::atomic<unsigned long long> water_consumed{ 0 };
+	};
+
+	// mean fitness and physical traits of the live organisms in a population at a point in time
+	struct PopulationSummary
+	{
+		unsigned int alive = 0;
+		double mean_fitness = 0;
+		double mean_area_of_influence = 0;
+		double mean_speed = 0;
+		double mean_health_rate = 0;
+		double mean_ideal_temp = 0;
+		double mean_temp_range = 0;
+	};
+
 	// A population of organisms
 	class Population : public SimulationObjectPool<Organism>
 	{
@@ -21,32 +52,42 @@ namespace GeneticSimulation
 		// initialize the population with a number of organisms
 		void init_random(unsigned int n, std::default_random_engine& rng);
 
-		// let organisms in given range interact with nearby organisms
-		void interact(unsigned int start, unsigned int end, std::default_random_engine& rng);
+		// let organisms in given range interact with nearby organisms, returning number of pair tests
+		// (recording gene transfers in the thread's lineage log if given)
+		unsigned long long interact(unsigned int start, unsigned int end, std::default_random_engine& rng,
+			LineageThreadLog* lineage = nullptr);
 
 		// let organisms in given range react to surrounding temperature
 		void react_to_temperature(unsigned int start, unsigned int end, unsigned int time);
 
-		// nourish organisms with given range of items in food pool
-		void nourish(unsigned int pool_start, unsigned int pool_end, std::default_random_engine& rng);
+		// get temperatures for every y coordinate at a timestep (waiting for them if computed in the
+		// background), which remain valid until the timestep after next is requested
+		const float* get_temperature_row(unsigned int time);
+
+		// nourish organisms with given range of items in food pool, returning number of range checks
+		unsigned long long nourish(unsigned int pool_start, unsigned int pool_end, std::default_random_engine& rng);
 
-		// hydrate organisms with given range of items in water pool
-		void hydrate(unsigned int pool_start, unsigned int pool_end, std::default_random_engine& rng);
+		// hydrate organisms with given range of items in water pool, returning number of range checks
+		unsigned long long hydrate(unsigned int pool_start, unsigned int pool_end, std::default_random_engine& rng);
 
-		// let organisms in given range potentially replicate themselves
-		void replicate(unsigned int start, unsigned int end, std::default_random_engine& rng);
+		// let organisms in given range potentially replicate themselves at the given timestep
+		// (recording births in the thread's lineage log if given)
+		void replicate(unsigned int start, unsigned int end, unsigned int time, std::default_random_engine& rng,
+			LineageThreadLog* lineage = nullptr);
 
 		// update phenotypes of each organism in given range if necessary
 		void update_phenotypes(unsigned int start, unsigned int end);
 
-		// update fitness of each organism in given range
-		void update_fitness(unsigned int start, unsigned int end);
+		// update fitness of each organism in given range, returning number of live organisms processed
+		// (recording deaths in the thread's lineage log if given)
+		unsigned long long update_fitness(unsigned int start, unsigned int end,
+			LineageThreadLog* lineage = nullptr);
 
-		// let organisms in given range determine heading to nearest food
-		void search_for_food(unsigned int start, unsigned int end);
+		// let organisms in given range determine heading to nearest food, returning number of items scanned
+		unsigned long long search_for_food(unsigned int start, unsigned int end);
 
-		// let organisms in given range determine heading to nearest water
-		void search_for_water(unsigned int start, unsigned int end);
+		// let organisms in given range determine heading to nearest water, returning number of items scanned
+		unsigned long long search_for_water(unsigned int start, unsigned int end);
 
 		// let organisms in given range decide on action based on sensory data
 		void think(unsigned int start, unsigned int end);
@@ -57,23 +98,50 @@ namespace GeneticSimulation
 		// update sprite of each organism in given range
 		void update_sprites(unsigned int start, unsigned int end);
 
+		// get running totals of population events
+		const PopulationCounters& get_counters() const;
+
+		// get tree of descent of live organisms
+		const Phylogeny& get_phylogeny() const;
+
+		// summarize fitness and physical traits of live organisms (should only be called
+		// while no simulation thread is updating existence, fitness or phenotypes)
+		PopulationSummary summarize() const;
+
+		// add memory used by organisms and their components to a footprint
+		void add_memory_usage(MemoryFootprint& footprint);
+
+		// write organisms, available slots, running totals, next organism id and phylogeny to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer);
+
+		// read organisms, available slots, running totals, next organism id and phylogeny from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 	private:
 
 		// resource pool types
 		enum resource_pool_type { food_pool, water_pool };
 
-		// distribute resources in given range of resource pool to organisms
-		void distribute_resources(unsigned int pool_start, unsigned int pool_end, 
+		// distribute resources in given range of resource pool to organisms, returning number of range checks
+		unsigned long long distribute_resources(unsigned int pool_start, unsigned int pool_end, 
 			resource_pool_type which_pool, std::default_random_engine& rng);
 		
 		// reference to area in which organisms exist
 		SimulationArea& area;
 		// reference to planet on which organisms exist
 		const Planet& planet;
+		// temperatures published from planet at the latest timesteps
+		TemperatureRows temperature_rows;
 		// reference to food and water pools which organisms consume from
 		ConsumableResourcePool& food;
 		ConsumableResourcePool& water;
 		// reference to simulation configuration options
 		const Config& config;
+		// running totals of population events
+		PopulationCounters counters;
+		// id given to the next organism initialized, so that ids are unique among all organisms
+		std::atomic<uint64_t> next_id{ 1 };
+		// tree of descent of live organisms, updated on every birth and death
+		Phylogeny phylogeny;
 	};
 }
\ No newline at end of file
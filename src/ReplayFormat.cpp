@@ -0,0 +1,199 @@
+#include "ReplayFormat.h"
+#include <cstring>
+#include <algorithm>
+
+using std::vector;
+using std::size_t;
+
+using namespace GeneticSimulation;
+
+static_assert(sizeof(ReplayHeader) == 64, "replay header must be 64 bytes");
+static_assert(sizeof(ReplayFrameHeader) == 12, "replay frame header must be 12 bytes");
+
+// identifier and format version of replay files
+const char GeneticSimulation::replay_magic[8] = "GSREPLY";
+const uint32_t GeneticSimulation::replay_version = 1;
+
+// append raw bytes of a value to a buffer
+template<class T>
+static void append(vector<char>& out, const T& value)
+{
+	auto bytes = reinterpret_cast<const char*>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// append an unsigned integer in 7-bit groups, least significant first, with the high bit marking continuation
+static void append_varint(vector<char>& out, uint32_t value)
+{
+	while (value >= 0x80) {
+		out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<char>(value));
+}
+
+// reads values from a payload, recording whether it ended early
+class PayloadReader
+{
+public:
+
+	PayloadReader(const char* data, size_t bytes) : data(data), end(data + bytes), valid(true) {}
+
+	template<class T>
+	T read() {
+		T value{};
+		if (static_cast<size_t>(end - data) < sizeof(T)) {
+			valid = false;
+			data = end;
+			return value;
+		}
+		std::memcpy(&value, data, sizeof(T));
+		data += sizeof(T);
+		return value;
+	}
+
+	uint32_t read_varint() {
+		uint32_t value = 0;
+		for (unsigned int shift = 0; shift < 35; shift += 7) {
+			auto byte = read<uint8_t>();
+			value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80)) return value;
+		}
+		valid = false;
+		return value;
+	}
+
+	bool at_end() const { return data == end; }
+	bool is_valid() const { return valid; }
+
+private:
+
+	const char* data;
+	const char* end;
+	bool valid;
+};
+
+// get largest power-of-two number of position units per cell for which an area fits in 16 bits
+uint32_t GeneticSimulation::get_replay_position_scale(unsigned int area_width, unsigned int area_height)
+{
+	uint32_t scale = 1;
+	while (scale < 64 && static_cast<uint64_t>(std::max(area_width, area_height)) * scale * 2 <= 65535) {
+		scale *= 2;
+	}
+	return scale;
+}
+
+// get largest power-of-two number of size units per cell (at most 16) for which a size fits in 8 bits
+uint32_t GeneticSimulation::get_replay_size_scale(float max_size)
+{
+	uint32_t scale = 1;
+	while (scale < 16 && max_size * scale * 2 <= 255) {
+		scale *= 2;
+	}
+	return scale;
+}
+
+// append keyframe payload for objects to a buffer
+void GeneticSimulation::encode_replay_keyframe(const vector<ReplayObject>& objects, vector<char>& out)
+{
+	for (auto& o : objects) {
+		append(out, o.exists);
+		if (!o.exists) continue;
+		append(out, o.x);
+		append(out, o.y);
+		append(out, o.size);
+		append(out, o.color);
+		append(out, o.outline);
+	}
+}
+
+// append delta frame payload for changes from previous to current objects to a buffer
+void GeneticSimulation::encode_replay_delta(const vector<ReplayObject>& previous, const vector<ReplayObject>& current,
+	vector<char>& out)
+{
+	size_t next = 0;
+	for (size_t i = 0; i < current.size(); i++) {
+		auto& p = previous[i];
+		auto& c = current[i];
+		// objects which do not exist in either frame have nothing to draw
+		if (!p.exists && !c.exists) continue;
+		// objects which stop existing are cleared, so only existence is recorded
+		if (!c.exists) {
+			append_varint(out, static_cast<uint32_t>(i - next));
+			append(out, static_cast<uint8_t>(exists_changed));
+			next = i + 1;
+			continue;
+		}
+
+		int dx = static_cast<int>(c.x) - p.x;
+		int dy = static_cast<int>(c.y) - p.y;
+		uint8_t mask = 0;
+		if (c.exists != p.exists) mask |= exists_changed;
+		if (dx != 0 || dy != 0) {
+			mask |= (dx >= -128 && dx <= 127 && dy >= -128 && dy <= 127) ? position_delta_changed : position_changed;
+		}
+		if (c.size != p.size) mask |= size_changed;
+		if (c.color != p.color) mask |= color_changed;
+		if (c.outline != p.outline) mask |= outline_changed;
+		if (!mask) continue;
+
+		append_varint(out, static_cast<uint32_t>(i - next));
+		append(out, mask);
+		if (mask & position_delta_changed) {
+			append(out, static_cast<int8_t>(dx));
+			append(out, static_cast<int8_t>(dy));
+		}
+		if (mask & position_changed) {
+			append(out, c.x);
+			append(out, c.y);
+		}
+		if (mask & size_changed) append(out, c.size);
+		if (mask & color_changed) append(out, c.color);
+		if (mask & outline_changed) append(out, c.outline);
+		next = i + 1;
+	}
+}
+
+// decode a keyframe or delta frame payload, updating objects, returning false if it is malformed
+bool GeneticSimulation::decode_replay_frame(const char* data, size_t bytes, bool keyframe, vector<ReplayObject>& objects)
+{
+	PayloadReader reader(data, bytes);
+	if (keyframe) {
+		for (auto& o : objects) {
+			o = ReplayObject{};
+			o.exists = reader.read<uint8_t>();
+			if (!o.exists) continue;
+			o.x = reader.read<uint16_t>();
+			o.y = reader.read<uint16_t>();
+			o.size = reader.read<uint8_t>();
+			o.color = reader.read<uint8_t>();
+			o.outline = reader.read<uint8_t>();
+		}
+		return reader.is_valid() && reader.at_end();
+	}
+
+	size_t next = 0;
+	while (!reader.at_end()) {
+		size_t i = next + reader.read_varint();
+		auto mask = reader.read<uint8_t>();
+		if (!reader.is_valid() || i >= objects.size()) return false;
+		auto& o = objects[i];
+		if (mask & exists_changed) {
+			if (o.exists) o = ReplayObject{};
+			else o.exists = 1;
+		}
+		if (mask & position_delta_changed) {
+			o.x = static_cast<uint16_t>(o.x + reader.read<int8_t>());
+			o.y = static_cast<uint16_t>(o.y + reader.read<int8_t>());
+		}
+		if (mask & position_changed) {
+			o.x = reader.read<uint16_t>();
+			o.y = reader.read<uint16_t>();
+		}
+		if (mask & size_changed) o.size = reader.read<uint8_t>();
+		if (mask & color_changed) o.color = reader.read<uint8_t>();
+		if (mask & outline_changed) o.outline = reader.read<uint8_t>();
+		next = i + 1;
+	}
+	return reader.is_valid();
+}
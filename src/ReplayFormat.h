@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace GeneticSimulation
+{
+	// quantized drawing state of one organism or resource item in a replay frame
+	struct ReplayObject
+	{
+		// position in units of 1 / position_scale cells
+		uint16_t x;
+		uint16_t y;
+		// size in units of 1 / size_scale cells
+		uint8_t size;
+		// fitness color as a fraction of 255 between low and high fitness colors (organisms only)
+		uint8_t color;
+		// progress of gene transfer outline effect, 0 if inactive or 1 + 254 * progress (organisms only)
+		uint8_t outline;
+		// whether object exists
+		uint8_t exists;
+	};
+
+	/*
+		Replay file layout (all values little-endian):
+
+		header     ReplayHeader below (64 bytes)
+		frames     for each recorded timestep, a ReplayFrameHeader followed by its payload
+		index      for each keyframe, uint32 frame number, uint32 timestep and uint64 file offset
+		           (written when recording finishes, and rebuilt by scanning frames if missing)
+
+		Objects are ordered population slots, then food slots, then water slots. A keyframe
+		payload holds each object in turn as a uint8 existence flag followed, if it exists, by
+		uint16 x, uint16 y, uint8 size, uint8 color and uint8 outline. A delta frame payload holds
+		only objects which changed since the previous frame, each as a varint gap from the object
+		after the previous changed one and a uint8 mask of replay_change flags followed by the
+		changed fields in flag order. Objects which do not exist have all fields cleared, so an
+		object which stops existing is recorded with only the existence flag.
+	*/
+	struct ReplayHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t area_width;
+		uint32_t area_height;
+		uint32_t population_slots;
+		uint32_t food_slots;
+		uint32_t water_slots;
+		uint32_t keyframe_interval;
+		uint32_t position_scale;
+		uint32_t size_scale;
+		uint32_t frames;
+		uint32_t keyframes;
+		uint32_t reserved;
+		uint64_t index_offset;
+	};
+
+	// header preceding each frame's payload
+	struct ReplayFrameHeader
+	{
+		uint32_t timestep;
+		uint32_t payload_bytes;
+		uint8_t keyframe;
+		uint8_t reserved[3];
+	};
+
+	// entry of keyframe index
+	struct ReplayKeyframe
+	{
+		uint32_t frame;
+		uint32_t timestep;
+		uint64_t offset;
+	};
+
+	// flags marking which fields of an object changed in a delta frame
+	enum replay_change : uint8_t {
+		// existence toggled
+		exists_changed = 1,
+		// position moved by int8 x and y deltas
+		position_delta_changed = 2,
+		// position moved too far for deltas, so given as uint16 x and y
+		position_changed = 4,
+		size_changed = 8,
+		color_changed = 16,
+		outline_changed = 32
+	};
+
+	// identifier and format version of replay files
+	extern const char replay_magic[8];
+	extern const uint32_t replay_version;
+
+	// get largest power-of-two number of position units per cell for which an area fits in 16 bits
+	uint32_t get_replay_position_scale(unsigned int area_width, unsigned int area_height);
+
+	// get largest power-of-two number of size units per cell (at most 16) for which a size fits in 8 bits
+	uint32_t get_replay_size_scale(float max_size);
+
+	// append keyframe payload for objects to a buffer
+	void encode_replay_keyframe(const std::vector<ReplayObject>& objects, std::vector<char>& out);
+
+	// append delta frame payload for changes from previous to current objects to a buffer
+	void encode_replay_delta(const std::vector<ReplayObject>& previous, const std::vector<ReplayObject>& current,
+		std::vector<char>& out);
+
+	// decode a keyframe or delta frame payload, updating objects, returning false if it is malformed
+	bool decode_replay_frame(const char* data, std::size_t bytes, bool keyframe, std::vector<ReplayObject>& objects);
+}
@@ -0,0 +1,157 @@
+#include "ReplayReader.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using std::string;
+using std::size_t;
+using std::cerr;
+
+using namespace GeneticSimulation;
+
+// constructor which maps the replay file and reads its keyframe index, scanning frames
+// to rebuild the index if recording did not finish
+GeneticSimulation::ReplayReader::ReplayReader(const string& path) :
+	header{}, frames(0), next_frame(0), next_offset(sizeof(ReplayHeader)), timestep(0), valid(false)
+{
+	try {
+		file.open(path);
+	}
+	catch (const std::exception& e) {
+		cerr << "Opening replay file " << path << " failed: " << e.what() << "\n";
+		return;
+	}
+	if (file.size() < sizeof(ReplayHeader)) {
+		cerr << "Replay file " << path << " is too short\n";
+		return;
+	}
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (std::memcmp(header.magic, replay_magic, sizeof(header.magic)) != 0 || header.version != replay_version ||
+		header.position_scale == 0 || header.size_scale == 0) {
+		cerr << "Replay file " << path << " is not a supported replay\n";
+		return;
+	}
+
+	// read keyframe index if recording finished, otherwise scan frame headers to rebuild it,
+	// stopping at the first incomplete frame
+	auto index_bytes = static_cast<uint64_t>(header.keyframes) * sizeof(ReplayKeyframe);
+	if (header.index_offset != 0 && header.index_offset + index_bytes <= file.size()) {
+		keyframes.resize(header.keyframes);
+		std::memcpy(keyframes.data(), file.data() + header.index_offset, index_bytes);
+		frames = header.frames;
+	}
+	else {
+		size_t offset = sizeof(ReplayHeader);
+		ReplayFrameHeader frame_header;
+		while (offset + sizeof(frame_header) <= file.size()) {
+			std::memcpy(&frame_header, file.data() + offset, sizeof(frame_header));
+			if (offset + sizeof(frame_header) + frame_header.payload_bytes > file.size()) break;
+			if (frame_header.keyframe) keyframes.push_back({ frames, frame_header.timestep, offset });
+			offset += sizeof(frame_header) + frame_header.payload_bytes;
+			frames++;
+		}
+		cerr << "Replay file " << path << " has no index as recording did not finish, found "
+			<< frames << " frames\n";
+	}
+	if (keyframes.empty() || keyframes[0].frame != 0) {
+		cerr << "Replay file " << path << " has no frames\n";
+		return;
+	}
+
+	objects.assign(static_cast<size_t>(header.population_slots) + header.food_slots + header.water_slots,
+		ReplayObject{});
+	valid = seek(0);
+}
+
+// get whether file was mapped and is a valid replay
+bool GeneticSimulation::ReplayReader::is_open() const
+{
+	return valid;
+}
+
+// get file header
+const GeneticSimulation::ReplayHeader& GeneticSimulation::ReplayReader::get_header() const
+{
+	return header;
+}
+
+// get number of frames
+unsigned int GeneticSimulation::ReplayReader::get_frames() const
+{
+	return frames;
+}
+
+// get number of current frame
+unsigned int GeneticSimulation::ReplayReader::get_frame() const
+{
+	return next_frame - 1;
+}
+
+// get timestep of current frame
+unsigned int GeneticSimulation::ReplayReader::get_timestep() const
+{
+	return timestep;
+}
+
+// get objects of current frame
+const std::vector<GeneticSimulation::ReplayObject>& GeneticSimulation::ReplayReader::get_objects() const
+{
+	return objects;
+}
+
+// get position of an object in cells
+sf::Vector2f GeneticSimulation::ReplayReader::get_position(const ReplayObject& object) const
+{
+	return sf::Vector2f(static_cast<float>(object.x) / header.position_scale,
+		static_cast<float>(object.y) / header.position_scale);
+}
+
+// get size of an object in cells
+float GeneticSimulation::ReplayReader::get_size(const ReplayObject& object) const
+{
+	return static_cast<float>(object.size) / header.size_scale;
+}
+
+// decode the given frame, returning whether successful
+bool GeneticSimulation::ReplayReader::seek(unsigned int frame)
+{
+	if (frame >= frames) return false;
+	// decode forward from the current frame if it is no later than the nearest keyframe,
+	// otherwise from the nearest keyframe at or before the given frame
+	auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(), frame,
+		[](unsigned int f, const ReplayKeyframe& k) { return f < k.frame; }) - 1;
+	if (next_frame == 0 || next_frame - 1 > frame || keyframe->frame >= next_frame) {
+		next_frame = keyframe->frame;
+		next_offset = keyframe->offset;
+	}
+	while (next_frame <= frame) {
+		if (!decode_frame(next_offset)) return false;
+		next_frame++;
+	}
+	return true;
+}
+
+// decode the frame after the current one, returning false at the end of the replay
+bool GeneticSimulation::ReplayReader::next()
+{
+	if (next_frame >= frames || !decode_frame(next_offset)) return false;
+	next_frame++;
+	return true;
+}
+
+// decode frame at the given offset, updating offset to the next frame, returning whether successful
+bool GeneticSimulation::ReplayReader::decode_frame(size_t& frame_offset)
+{
+	ReplayFrameHeader frame_header;
+	if (frame_offset + sizeof(frame_header) > file.size()) return false;
+	std::memcpy(&frame_header, file.data() + frame_offset, sizeof(frame_header));
+	auto payload = frame_offset + sizeof(frame_header);
+	if (payload + frame_header.payload_bytes > file.size() ||
+		!decode_replay_frame(file.data() + payload, frame_header.payload_bytes, frame_header.keyframe != 0, objects)) {
+		cerr << "Replay frame at offset " << frame_offset << " is malformed\n";
+		return false;
+	}
+	timestep = frame_header.timestep;
+	frame_offset = payload + frame_header.payload_bytes;
+	return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ReplayFormat.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <SFML/System.hpp>
+
+namespace GeneticSimulation
+{
+	// Reads frames from a memory-mapped replay file, decoding forward from the nearest keyframe
+	// when seeking so that any frame can be reached without decoding the whole replay
+	class ReplayReader
+	{
+	public:
+
+		// constructor which maps the replay file and reads its keyframe index, scanning frames
+		// to rebuild the index if recording did not finish
+		explicit ReplayReader(const std::string& path);
+
+		// get whether file was mapped and is a valid replay
+		bool is_open() const;
+
+		// get file header
+		const ReplayHeader& get_header() const;
+
+		// get number of frames
+		unsigned int get_frames() const;
+
+		// get number of current frame
+		unsigned int get_frame() const;
+
+		// get timestep of current frame
+		unsigned int get_timestep() const;
+
+		// get objects of current frame
+		const std::vector<ReplayObject>& get_objects() const;
+
+		// get position of an object in cells
+		sf::Vector2f get_position(const ReplayObject& object) const;
+
+		// get size of an object in cells
+		float get_size(const ReplayObject& object) const;
+
+		// decode the given frame, returning whether successful
+		bool seek(unsigned int frame);
+
+		// decode the frame after the current one, returning false at the end of the replay
+		bool next();
+
+	private:
+
+		// decode frame at the given offset, updating offset to the next frame, returning whether successful
+		bool decode_frame(std::size_t& frame_offset);
+
+		// mapped replay file
+		boost::iostreams::mapped_file_source file;
+		// file header
+		ReplayHeader header;
+		// keyframe index
+		std::vector<ReplayKeyframe> keyframes;
+		// objects of current frame
+		std::vector<ReplayObject> objects;
+		// number of frames, number of next frame to decode and its file offset, and timestep of current frame
+		unsigned int frames;
+		unsigned int next_frame;
+		std::size_t next_offset;
+		unsigned int timestep;
+		// whether file is a valid replay
+		bool valid;
+	};
+}
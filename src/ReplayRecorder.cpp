@@ -0,0 +1,182 @@
+#include "ReplayRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::min;
+using std::max;
+
+using namespace GeneticSimulation;
+
+// number of recorded bytes after which frames are submitted to be written
+static const std::size_t flush_bytes = 256 * 1024;
+
+// constructor which takes the file path, frames between keyframes, area size, number of
+// population, food and water slots, largest object size and gene transfer effect length
+GeneticSimulation::ReplayRecorder::ReplayRecorder(const string& path, unsigned int keyframe_interval,
+	sf::Vector2u area_size, unsigned int population_slots, unsigned int food_slots, unsigned int water_slots,
+	float max_size, float transfer_effect_len) :
+	path(path), header{}, transfer_effect_len(transfer_effect_len), offset(sizeof(ReplayHeader)),
+	has_pending(false), stop(false), failed(false)
+{
+	std::memcpy(header.magic, replay_magic, sizeof(header.magic));
+	header.version = replay_version;
+	header.area_width = area_size.x;
+	header.area_height = area_size.y;
+	header.population_slots = population_slots;
+	header.food_slots = food_slots;
+	header.water_slots = water_slots;
+	header.keyframe_interval = max(1u, keyframe_interval);
+	header.position_scale = get_replay_position_scale(area_size.x, area_size.y);
+	header.size_scale = get_replay_size_scale(max_size);
+
+	file.open(path, ios::binary | ios::trunc);
+	if (!file) {
+		cerr << "Opening replay file " << path << " failed: Check that the path exists and may be written to\n";
+		return;
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	auto slots = static_cast<std::size_t>(population_slots) + food_slots + water_slots;
+	previous.assign(slots, ReplayObject{});
+	current.assign(slots, ReplayObject{});
+	recording.reserve(flush_bytes + slots * sizeof(ReplayObject));
+	writer_thread = std::thread([this] { run(); });
+}
+
+// destructor which writes all recorded frames followed by the keyframe index
+GeneticSimulation::ReplayRecorder::~ReplayRecorder()
+{
+	if (!writer_thread.joinable()) return;
+
+	// submit remaining frames once the writer has picked up any before them, then stop
+	{
+		std::unique_lock<std::mutex> lock(mx);
+		frames_picked_up.wait(lock, [&] { return !has_pending; });
+		std::swap(recording, pending);
+		has_pending = true;
+		stop = true;
+	}
+	frames_submitted.notify_one();
+	writer_thread.join();
+
+	// append keyframe index and update header so that readers can seek without scanning frames
+	header.keyframes = static_cast<uint32_t>(keyframes.size());
+	header.index_offset = offset;
+	file.write(reinterpret_cast<const char*>(keyframes.data()), keyframes.size() * sizeof(ReplayKeyframe));
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.close();
+	if (failed || !file) {
+		cerr << "Writing replay file " << path << " failed\n";
+		return;
+	}
+	cout << "Wrote replay to " << path << " (" << header.frames << " frames, " << header.keyframes
+		<< " keyframes, " << (offset + keyframes.size() * sizeof(ReplayKeyframe)) / 1024 << " KiB, "
+		<< (header.frames ? (offset - sizeof(ReplayHeader)) / header.frames : 0) << " bytes per frame)\n";
+}
+
+// get whether file was opened
+bool GeneticSimulation::ReplayRecorder::is_open() const
+{
+	return writer_thread.joinable();
+}
+
+// record a frame of organisms and resource items at a timestep (should only be called by
+// one thread at a time while no simulation thread is updating organisms or resources)
+void GeneticSimulation::ReplayRecorder::record(unsigned int timestep, const Population& population,
+	const ConsumableResourcePool& food, const ConsumableResourcePool& water)
+{
+	// quantize drawing state of organisms, with fitness color and gene transfer effect, then resources
+	std::size_t i = 0;
+	for (unsigned int j = 0; j < population.get_max_size(); j++, i++) {
+		auto& organism = population[j];
+		current[i] = quantize(organism);
+		if (!current[i].exists) continue;
+		current[i].color = static_cast<uint8_t>(std::lround(organism.get_health() * 255));
+		auto progress = organism.get_transfer_effect_progress(transfer_effect_len);
+		current[i].outline = progress < 0 ? 0 : static_cast<uint8_t>(1 + std::lround(min(1.f, progress) * 254));
+	}
+	for (auto pool : { &food, &water }) {
+		for (unsigned int j = 0; j < pool->get_max_size(); j++, i++) {
+			current[i] = quantize((*pool)[j]);
+		}
+	}
+
+	// append frame, as a keyframe at each keyframe interval and otherwise as changes from previous frame
+	bool keyframe = header.frames % header.keyframe_interval == 0;
+	if (keyframe) {
+		keyframes.push_back({ header.frames, timestep, offset });
+	}
+	auto frame_start = recording.size();
+	recording.resize(frame_start + sizeof(ReplayFrameHeader));
+	if (keyframe) {
+		encode_replay_keyframe(current, recording);
+	}
+	else {
+		encode_replay_delta(previous, current, recording);
+	}
+	ReplayFrameHeader frame_header = {};
+	frame_header.timestep = timestep;
+	frame_header.payload_bytes = static_cast<uint32_t>(recording.size() - frame_start - sizeof(ReplayFrameHeader));
+	frame_header.keyframe = keyframe ? 1 : 0;
+	std::memcpy(&recording[frame_start], &frame_header, sizeof(frame_header));
+	offset += recording.size() - frame_start;
+	header.frames++;
+	std::swap(previous, current);
+
+	// submit frames to be written once enough have been recorded, unless the writer has not yet
+	// picked up the last ones, in which case keep recording into the same buffer
+	if (recording.size() >= flush_bytes) {
+		std::unique_lock<std::mutex> lock(mx, std::try_to_lock);
+		if (lock.owns_lock() && !has_pending) {
+			std::swap(recording, pending);
+			has_pending = true;
+			lock.unlock();
+			frames_submitted.notify_one();
+		}
+	}
+}
+
+// write submitted frames until stopped
+void GeneticSimulation::ReplayRecorder::run()
+{
+	while (true) {
+		// wait for frames and swap them into the buffer being written, so that recording can
+		// continue meanwhile, or return once stopped and there are none left
+		bool last;
+		{
+			std::unique_lock<std::mutex> lock(mx);
+			frames_submitted.wait(lock, [&] { return stop || has_pending; });
+			if (!has_pending) return;
+			std::swap(pending, writing);
+			has_pending = false;
+			last = stop;
+		}
+		frames_picked_up.notify_all();
+
+		file.write(writing.data(), writing.size());
+		if (!file) failed = true;
+		writing.clear();
+		if (last) return;
+	}
+}
+
+// quantize drawing state of an object into a replay object
+GeneticSimulation::ReplayObject GeneticSimulation::ReplayRecorder::quantize(const SimulationObject& object) const
+{
+	ReplayObject o = {};
+	o.exists = object.get_exists() ? 1 : 0;
+	if (!o.exists) return o;
+	auto position = object.get_position();
+	o.x = static_cast<uint16_t>(min(65535L, max(0L, std::lround(position.x * header.position_scale))));
+	o.y = static_cast<uint16_t>(min(65535L, max(0L, std::lround(position.y * header.position_scale))));
+	o.size = static_cast<uint8_t>(min(255L, max(0L, std::lround(object.get_size() * header.size_scale))));
+	return o;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ReplayFormat.h"
+#include "Population.h"
+#include "ConsumableResourcePool.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <cstdint>
+#include <SFML/System.hpp>
+
+namespace GeneticSimulation
+{
+	// Records the drawing state of every organism and resource item at each timestep into a
+	// replay file, quantizing and delta encoding frames at the end of a timestep and leaving
+	// writing them to a background thread
+	class ReplayRecorder
+	{
+	public:
+
+		// constructor which takes the file path, frames between keyframes, area size, number of
+		// population, food and water slots, largest object size and gene transfer effect length
+		ReplayRecorder(const std::string& path, unsigned int keyframe_interval, sf::Vector2u area_size,
+			unsigned int population_slots, unsigned int food_slots, unsigned int water_slots,
+			float max_size, float transfer_effect_len);
+
+		// destructor which writes all recorded frames followed by the keyframe index
+		~ReplayRecorder();
+
+		// get whether file was opened
+		bool is_open() const;
+
+		// record a frame of organisms and resource items at a timestep (should only be called by
+		// one thread at a time while no simulation thread is updating organisms or resources)
+		void record(unsigned int timestep, const Population& population,
+			const ConsumableResourcePool& food, const ConsumableResourcePool& water);
+
+	private:
+
+		// write submitted frames until stopped
+		void run();
+
+		// quantize drawing state of an object into a replay object
+		ReplayObject quantize(const SimulationObject& object) const;
+
+		// path of replay file
+		const std::string path;
+		// replay file
+		std::ofstream file;
+		// file header, updated with frame counts and index offset when recording finishes
+		ReplayHeader header;
+		// length of gene transfer graphical effect in timesteps
+		const float transfer_effect_len;
+		// objects in previous and current frame
+		std::vector<ReplayObject> previous;
+		std::vector<ReplayObject> current;
+		// keyframe index
+		std::vector<ReplayKeyframe> keyframes;
+		// file offset of next frame
+		uint64_t offset;
+		// frames being recorded, frames submitted to be written and frames being written
+		std::vector<char> recording;
+		std::vector<char> pending;
+		std::vector<char> writing;
+		// whether frames are waiting to be written, whether thread should stop and whether writing failed
+		bool has_pending;
+		bool stop;
+		bool failed;
+		// mutex and condition variables for submitting frames and waiting for them to be picked up
+		std::mutex mx;
+		std::condition_variable frames_submitted;
+		std::condition_variable frames_picked_up;
+		// background thread writing frames
+		std::thread writer_thread;
+	};
+}
@@ -53,6 +53,24 @@ const std::vector<float>& GeneticSimulation::SensoryData::get_data()
 	return data;
 }
 
+// get heap memory used by sensory values in bytes
+std::size_t GeneticSimulation::SensoryData::get_memory_usage() const
+{
+	return data.capacity() * sizeof(float);
+}
+
+// write sensory values to a checkpoint
+void GeneticSimulation::SensoryData::write_checkpoint(CheckpointWriter& writer) const
+{
+	writer.write_vector(data);
+}
+
+// read sensory values from a checkpoint
+void GeneticSimulation::SensoryData::read_checkpoint(CheckpointReader& reader)
+{
+	reader.read_vector(data);
+}
+
 // sets scaled hunger value based on nutrition
 void GeneticSimulation::SensoryData::set_hunger(unsigned int nutrition)
 {
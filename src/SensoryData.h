@@ -1,6 +1,8 @@
 #pragma once
 
+#include "helper/Checkpoint.h"
 #include <vector>
+#include <cstddef>
 
 namespace GeneticSimulation
 {
@@ -37,6 +39,15 @@ namespace GeneticSimulation
 		// returns a reference to the vector of scaled sensory values
 		const std::vector<float>& get_data();
 
+		// get heap memory used by sensory values in bytes
+		std::size_t get_memory_usage() const;
+
+		// write sensory values to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read sensory values from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 		// sets scaled hunger value based on nutrition
 		void set_hunger(unsigned int nutrition);
 
@@ -1,12 +1,24 @@
 #include "Simulation.h"
+#include "WorkCounters.h"
+#include "PhaseTimer.h"
+#include "ValidationHarness.h"
+#include "EnsembleRunner.h"
+#include "TemperatureModel.h"
 #include "helper/SignalLink.h"
 #include "helper/benchmark_helper.h"
+#include "helper/allocation_tracker.h"
+#include "helper/memory_usage.h"
+#include "engine/SimulationObject.h"
 #include <random>
 #include <vector>
 #include <memory>
 #include <chrono>
 #include <algorithm>
 #include <string>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/filesystem.hpp>
@@ -24,9 +36,16 @@ using std::min;
 using std::max;
 using std::string;
 using std::to_string;
+using std::function;
+using std::cout;
+using std::cerr;
+using std::size_t;
 
-// constructor
-GeneticSimulation::Simulation::Simulation(const Config& config) : initialized(false), config(config) {}
+// constructor which optionally takes a planet with temperatures already precomputed for the
+// config, which is only read and so may be shared with other simulations
+GeneticSimulation::Simulation::Simulation(const Config& config, std::shared_ptr<Planet> planet) : 
+	initialized(false), headless(false), num_simulation_threads(1), timestep(0), 
+	checkpoint_requested(false), planet_ptr(std::move(planet)), config(config) {}
 
 // initialize simulation by creating and initializing the necessary components
 void GeneticSimulation::Simulation::init()
@@ -34,6 +53,36 @@ void GeneticSimulation::Simulation::init()
 	// create random number generator
 	default_random_engine rng(-config.random_seed_factor);
 
+	// print memory footprint estimate before allocating anything if reporting memory or only estimating
+	if (config.memory_report || config.run_mode == 4) {
+		estimate_memory_footprint(config).print(cout, "estimated");
+		// nothing else needs to be initialized if only estimating memory footprint
+		if (config.run_mode == 4) {
+			initialized = true;
+			return;
+		}
+	}
+
+	// validation harness and ensemble runner create their own simulations for each run
+	if (config.run_mode == 5 || config.run_mode == 7) {
+		initialized = true;
+		return;
+	}
+
+	// run without a window if configured or if checking allocations
+	headless = config.headless || config.run_mode == 3;
+
+	// get number of simulation threads from config and set to number of hardware processors if 0
+	num_simulation_threads = config.simulation_threads == 0 ? 
+		boost::thread::hardware_concurrency() : 
+		config.simulation_threads;
+
+	// create random number generator for each simulation thread
+	simulation_rngs.clear();
+	for (unsigned int i = 0; i < num_simulation_threads; i++) {
+		simulation_rngs.emplace_back(i * config.random_seed_factor);
+	}
+
 	// load font
 	namespace fs = boost::filesystem;
 	for (auto& p : vector<fs::path>{ "data", "../data", "./" }) {
@@ -48,14 +97,17 @@ void GeneticSimulation::Simulation::init()
 		config.title,
 		config.standard_framerate,
 		window,
-		font
+		font,
+		headless
 	);
 	area_ptr->set_limit_frame_rate(true);
 
-	// set up planet
-	planet_ptr = make_unique<Planet>();
-	// precompute temperatures once if not benchmarking this
-	if (config.run_mode != 2) planet_ptr->precompute_temperatures(config);
+	// set up planet unless one was given
+	if (!planet_ptr) {
+		planet_ptr = std::make_shared<Planet>();
+		// precompute temperatures once if not benchmarking this or playing back a replay
+		if (config.run_mode != 2 && config.run_mode != 6) planet_ptr->precompute_temperatures(config);
+	}
 
 	// set up food pool
 	food_pool_ptr = make_unique<ConsumableResourcePool>(
@@ -87,15 +139,89 @@ void GeneticSimulation::Simulation::init()
 	);
 	population_ptr->init_random(config.population_init, rng);
 
+	// replay only shows recorded frames in the population and resource pools, so nothing else is needed
+	if (config.run_mode == 6) {
+		initialized = true;
+		return;
+	}
+
+	// replace initial state with checkpointed state if restoring, and abort if this fails
+	if (!config.checkpoint_restore_path.empty()) {
+		if (!restore_checkpoint(config.checkpoint_restore_path)) return;
+		planet_ptr->start_at_timestep(timestep, config);
+	}
+
+	// start writing checkpoints in the background if they may be requested by key or interval
+	if (!headless || config.checkpoint_interval != 0) {
+		checkpoint_writer_ptr = make_unique<AsyncCheckpointWriter>(config.checkpoint_path, config.checkpoint_keep);
+	}
+
+	// start writing telemetry in the background if enabled
+	if (!config.telemetry_path.empty()) {
+		telemetry_writer_ptr = make_unique<TelemetryWriter>(config.telemetry_path, config.telemetry_queue_capacity,
+			config.telemetry_chunk_rows, config.population_size);
+		if (!telemetry_writer_ptr->is_open()) telemetry_writer_ptr.reset();
+	}
+
+	// start writing genome archives in the background if enabled
+	if (!config.genome_archive_path.empty()) {
+		genome_archive_writer_ptr = make_unique<GenomeArchiveWriter>(config.genome_archive_path,
+			config.genome_archive_precision, config.genome_archive_compression, config.genome_archive_block_genomes,
+			config.behaviour_net_layer_1_units, config.behaviour_net_layer_2_units);
+	}
+
+	// start recording a replay in the background if enabled
+	if (!config.replay_record_path.empty()) {
+		replay_recorder_ptr = make_unique<ReplayRecorder>(config.replay_record_path, config.replay_keyframe_interval,
+			area_ptr->get_size(), config.population_size, config.food_pool_size, config.water_pool_size,
+			max(6.f, config.area_of_influence_mean + 6 * config.area_of_influence_sigma),
+			config.standard_framerate * 1.5f);
+		if (!replay_recorder_ptr->is_open()) replay_recorder_ptr.reset();
+	}
+
+	// start rendering frames offscreen in the background if enabled
+	if (!config.frames_path.empty()) {
+		frame_renderer_ptr = make_unique<FrameRenderer>(config.frames_path, area_ptr->get_size(), config.frames_scale,
+			sf::Color(config.background_color), food_pool_ptr->get_item_color(), water_pool_ptr->get_item_color(),
+			config.standard_framerate * 1.5f, config.frames_snapshots, config.frames_encode_threads);
+	}
+
+	// start logging lineage events in the background if enabled
+	if (!config.lineage_path.empty()) {
+		lineage_log_ptr = make_unique<LineageLog>(config.lineage_path, num_simulation_threads,
+			config.lineage_ring_capacity, timestep);
+		if (!lineage_log_ptr->is_open()) lineage_log_ptr.reset();
+	}
+
+	// set up metrics and start serving them if enabled
+	if (config.metrics_port != 0) {
+		metrics_ptr = make_unique<SimulationMetrics>(*population_ptr);
+		metrics_ptr->set_memory_footprint(measure_memory_footprint());
+		metrics_server_ptr = make_unique<MetricsServer>(config.metrics_address,
+			static_cast<unsigned short>(config.metrics_port),
+			[this] { return metrics_ptr->render(); });
+		metrics_server_ptr->start();
+	}
+
+	// set up allocation counters if allocation tracking is compiled in
+	if (allocation_tracking_enabled) {
+		allocation_counters_ptr = make_unique<AllocationCounters>(num_simulation_threads);
+	}
+
+	// report measured memory footprint if enabled
+	if (config.memory_report) {
+		print_memory_report();
+	}
+
 	// record initialization
 	initialized = true;
 }
 
-// run task based on run mode in config
-void GeneticSimulation::Simulation::run()
+// run task based on run mode in config, returning exit status
+int GeneticSimulation::Simulation::run()
 {
 	// return if not initialized
-	if (!initialized) return;
+	if (!initialized) return 1;
 
 	// run task based on run mode
 	switch (config.run_mode) {
@@ -111,21 +237,125 @@ void GeneticSimulation::Simulation::run()
 		// run mode 2: benchmark temperature computation
 		planet_ptr->precompute_temperatures(config, true);
 		break;
+	case 3:
+		// run mode 3: check steady-state loop for heap allocations
+		return check_allocations();
+	case 4:
+		// run mode 4: estimate memory footprint (already printed during initialization)
+		break;
+	case 5:
+		// run mode 5: validate statistics against single-threaded reference
+		return ValidationHarness(config).run();
+	case 6:
+		// run mode 6: play back a recorded replay
+		return run_replay();
+	case 7:
+		// run mode 7: run an ensemble of seeds concurrently on a bounded pool of workers sharing one planet
+		return EnsembleRunner(config).run();
 	default:
 		// run multithreaded by default
 		run_threaded();
 		break;
 	}
+
+	return 0;
 }
 
-// run simulation using at least 1 simulation thread and 1 render thread
-void GeneticSimulation::Simulation::run_threaded(bool benchmark)
+// estimate memory footprint of simulation components from config without allocating them
+GeneticSimulation::MemoryFootprint GeneticSimulation::Simulation::estimate_memory_footprint(const Config& config)
 {
-	// get number of simulation threads from config and set to number of hardware processors if 0
-	auto num_simulation_threads = config.simulation_threads == 0 ? 
-		boost::thread::hardware_concurrency() : 
-		config.simulation_threads;
+	MemoryFootprint footprint;
+	// objects are drawn from a batch of vertices per pool, holding at most every object with the most points
+	size_t vertex_bytes = config.headless ? 0 : SimulationArea::max_circle_vertices * sizeof(sf::Vertex);
+	// and found near the viewport through a spatial grid per pool, over an area of at least 300 by 300
+	sf::Vector2u area_size(max(300u, config.area_width), max(300u, config.area_height));
+
+	// temperature lookup table holds one value per row of area per timestep of orbit, or if factored
+	// two values per timestep and one more than the number of sampled tilts per row, or if sampled one value
+	// per row per sampled timestep and three more for interpolating across the start and end of the orbit
+	size_t temperature_cells = static_cast<size_t>(config.area_height) * config.orbital_period;
+	switch (config.planet_temperature_storage) {
+	case quantized_storage:
+		footprint.add("planet_temperatures", temperature_cells * sizeof(uint16_t));
+		break;
+	case windowed_storage:
+		footprint.add("planet_temperatures", static_cast<size_t>(config.area_height) * config.planet_temperature_window * sizeof(float));
+		break;
+	case sampled_storage:
+		footprint.add("planet_temperatures", static_cast<size_t>(config.area_height) * 
+			((config.orbital_period + config.planet_temperature_stride - 1) / config.planet_temperature_stride + 3) * sizeof(float));
+		break;
+	case factored_storage:
+		footprint.add("planet_temperatures", (2 * static_cast<size_t>(config.orbital_period) + 
+			static_cast<size_t>(config.area_height) * ((config.axial_tilt > 0 ? config.planet_tilt_samples : 1) + 1)) * sizeof(float));
+		break;
+	default:
+		footprint.add("planet_temperatures", temperature_cells * sizeof(float));
+		break;
+	}
+
+	// resource pools hold fixed-size items, their vertices and a queue of free slots
+	for (auto& pool : { std::make_pair(string("food"), config.food_pool_size),
+		std::make_pair(string("water"), config.water_pool_size) }) {
+		footprint.add(pool.first + "_objects", pool.second * sizeof(ConsumableResource));
+		footprint.add(pool.first + "_vertices", pool.second * vertex_bytes);
+		if (!config.headless) {
+			footprint.add(pool.first + "_spatial_grid", SpatialGrid::estimate_memory_usage(area_size, pool.second) +
+				pool.second * sizeof(unsigned int));
+		}
+		footprint.add(pool.first + "_free_slots", pool.second * sizeof(unsigned int));
+	}
 
+	// population holds organisms, their vertices, a queue of free slots and a phylogeny, and each
+	// organism holds a collision record for the whole population, a genotype and sensory data
+	size_t organisms = config.population_size;
+	size_t nh1 = config.behaviour_net_layer_1_units;
+	size_t nh2 = config.behaviour_net_layer_2_units;
+	size_t weights = 7 * nh1 + nh1 * nh2 + nh2 * 2;
+	size_t activations = nh1 + nh2 + 2;
+	size_t trait_genes = 15;
+	footprint.add("population_objects", organisms * sizeof(Organism));
+	footprint.add("population_vertices", organisms * vertex_bytes);
+	if (!config.headless) {
+		footprint.add("population_spatial_grid", SpatialGrid::estimate_memory_usage(area_size, config.population_size) +
+			organisms * sizeof(unsigned int));
+	}
+	footprint.add("population_free_slots", organisms * sizeof(unsigned int));
+	footprint.add("population_collisions", organisms * organisms * sizeof(uint8_t));
+	footprint.add("population_genotypes", organisms * (weights + activations + trait_genes) * sizeof(float));
+	footprint.add("population_sensory_data", organisms * 7 * sizeof(float));
+	footprint.add("population_phylogeny", Phylogeny::estimate_memory_usage(config.population_size));
+
+	return footprint;
+}
+
+// measure memory footprint of initialized simulation components
+GeneticSimulation::MemoryFootprint GeneticSimulation::Simulation::measure_memory_footprint()
+{
+	MemoryFootprint footprint;
+	planet_ptr->add_memory_usage(footprint);
+	food_pool_ptr->add_memory_usage(footprint, "food");
+	water_pool_ptr->add_memory_usage(footprint, "water");
+	population_ptr->add_memory_usage(footprint);
+	return footprint;
+}
+
+// run simulation headless for the given number of timesteps, calling the given function with
+// the population after each timestep while no simulation thread is updating existence,
+// fitness or phenotypes
+void GeneticSimulation::Simulation::run_headless(unsigned int timesteps,
+	const function<void(unsigned int, const Population&)>& timestep_done)
+{
+	headless = true;
+	run_threaded(false, timesteps, [&](unsigned int t) { timestep_done(t, *population_ptr); });
+}
+
+// run simulation using at least 1 simulation thread and 1 render thread, or if headless 
+// the main thread, for the given number of timesteps (0 = unlimited, ignored if not headless)
+// and calling the given function after each timestep if headless
+void GeneticSimulation::Simulation::run_threaded(bool benchmark, unsigned int timesteps,
+	const function<void(unsigned int)>& timestep_done)
+{
 	// calculate number of organisms, food items and water items to process per thread
 	unsigned int organisms_per_thread = config.population_size / num_simulation_threads + 1;
 	unsigned int food_items_per_thread = config.food_pool_size / num_simulation_threads + 1;
@@ -134,7 +364,34 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 	// barriers for synchronizing simulation threads
 	boost::barrier replication_begin_barrier(num_simulation_threads);
 	boost::barrier replication_end_barrier(num_simulation_threads);
-	boost::barrier end_of_timestep_barrier(num_simulation_threads);
+	// the last thread to reach the end of a timestep advances the timestep and, while every other
+	// thread is waiting, records telemetry and a replay frame, copies drawing state for a rendered
+	// frame and genomes for archiving and snapshots state for a checkpoint if one was requested or
+	// the intervals have elapsed, leaving all to be rendered or written in the background
+	boost::barrier end_of_timestep_barrier(num_simulation_threads, [&] {
+		timestep++;
+		if (replay_recorder_ptr) {
+			replay_recorder_ptr->record(timestep, *population_ptr, *food_pool_ptr, *water_pool_ptr);
+		}
+		if (frame_renderer_ptr && timestep % config.frames_interval == 0) {
+			frame_renderer_ptr->snapshot(timestep, *population_ptr, *food_pool_ptr, *water_pool_ptr);
+		}
+		if (telemetry_writer_ptr && timestep % config.telemetry_interval == 0) {
+			telemetry_writer_ptr->record(timestep, *population_ptr, *food_pool_ptr, *water_pool_ptr);
+		}
+		if (genome_archive_writer_ptr && timestep % config.genome_archive_interval == 0) {
+			genome_archive_writer_ptr->snapshot(timestep, *population_ptr);
+		}
+		if (checkpoint_writer_ptr && (checkpoint_requested.exchange(false) ||
+			(config.checkpoint_interval != 0 && timestep % config.checkpoint_interval == 0))) {
+			snapshot_checkpoint();
+		}
+	});
+	// timestep to start from
+	unsigned int start_timestep = timestep;
+
+	// per-thread work counters
+	WorkCounters work_counters(num_simulation_threads);
 
 	// signal links for synchronizing simulation threads with render thread
 	SignalLink draw_resources_begin_signal_link(num_simulation_threads, 1);
@@ -146,6 +403,12 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 		area_ptr->set_limit_frame_rate(false);
 	}
 
+	// find objects to draw through spatial grids of the pools, which simulation threads update before
+	// signalling that each pool may be drawn
+	if (!headless) {
+		enable_spatial_grids();
+	}
+
 	// create vector for pointers to simulation thread objects
 	vector<unique_ptr<boost::thread>> simulation_threads;
 
@@ -154,8 +417,8 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 		simulation_threads.push_back(make_unique<boost::thread>(
 			// thread function
 			[&, i] {
-				// create thread-local random number generator
-				default_random_engine rng(i * config.random_seed_factor);
+				// get thread's random number generator
+				auto& rng = simulation_rngs[i];
 				// calculate organism, food item and water item start and end indices for thread
 				unsigned int organism_start = i * organisms_per_thread;
 				unsigned int organism_end = (i + 1) * organisms_per_thread;
@@ -164,7 +427,16 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 				unsigned int water_start = i * water_items_per_thread;
 				unsigned int water_end = (i + 1) * water_items_per_thread;
 				// timestep counter
-				unsigned int t = 0;
+				unsigned int t = start_timestep;
+				// phase timer, recording durations into metrics on the first thread only
+				// and allocations into allocation counters if tracking is enabled
+				PhaseTimer phase_timer(i == 0 ? metrics_ptr.get() : nullptr, 
+					allocation_counters_ptr ? &allocation_counters_ptr->get_thread(i) : nullptr);
+				// work counters for thread, and timer for waits if reporting work
+				auto& work = work_counters.get_thread(i);
+				WaitTimer wait_timer(config.work_report ? &work : nullptr);
+				// thread's lineage event ring buffer if logging lineage
+				auto lineage = lineage_log_ptr ? &lineage_log_ptr->get_thread(i) : nullptr;
 				// loop until thread is interrupted
 				while (true) {
 					/*
@@ -175,7 +447,8 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						Reads existence, fitness, age and position of every other organism so
 						conflicts with replicate, update fitness and move which write these
 					*/
-					population_ptr->interact(organism_start, organism_end, rng);
+					work.work[interact_pair_tests] += population_ptr->interact(organism_start, organism_end, rng, lineage);
+					phase_timer.lap(interact_phase);
 
 					/*
 						React to temperature
@@ -184,9 +457,13 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						apart from precomputed temperature data which does not change
 					*/
 					population_ptr->react_to_temperature(organism_start, organism_end, t);
+					phase_timer.lap(react_to_temperature_phase);
 
 					// wait for render thread to signal it is finished its last iteration
+					wait_timer.start();
 					draw_done_signal_link.wait();
+					wait_timer.stop(draw_done_wait);
+					phase_timer.reset();
 
 					/*
 						Distribute resources
@@ -198,14 +475,20 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						organism, so conflicts with replicate, update fitness, move, update phenotype,
 						search for resources and update sprite which write/read these in conflicting way
 					*/
-					population_ptr->nourish(food_start, food_end, rng);
-					population_ptr->hydrate(water_start, water_end, rng);
+					work.work[resource_range_checks] += population_ptr->nourish(food_start, food_end, rng);
+					work.work[resource_range_checks] += population_ptr->hydrate(water_start, water_end, rng);
+					food_pool_ptr->update_spatial_grid(food_start, food_end);
+					water_pool_ptr->update_spatial_grid(water_start, water_end);
+					phase_timer.lap(distribute_resources_phase);
 					
 					// notify render thread that drawing of resources may begin
 					draw_resources_begin_signal_link.notify();
 
 					// wait until all previous tasks are finished
+					wait_timer.start();
 					replication_begin_barrier.wait();
+					wait_timer.stop(replication_begin_wait);
+					phase_timer.reset();
 
 					/*
 						Replicate
@@ -214,10 +497,14 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 
 						Conflicts with all other tasks as it may reset any dead organism
 					*/
-					population_ptr->replicate(organism_start, organism_end, rng);
+					population_ptr->replicate(organism_start, organism_end, t, rng, lineage);
+					phase_timer.lap(replicate_phase);
 
 					// wait until all replication is done
+					wait_timer.start();
 					replication_end_barrier.wait();
+					wait_timer.stop(replication_end_wait);
+					phase_timer.reset();
 
 					/*
 						Update phenotypes
@@ -225,13 +512,16 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						Parallelizable across population as each organism only reads and writes own data
 					*/
 					population_ptr->update_phenotypes(organism_start, organism_end);
+					phase_timer.lap(update_phenotypes_phase);
 
 					/*
 						Update fitness
 
 						Parallelizable across population as available slots queue is protected by a mutex
 					*/
-					population_ptr->update_fitness(organism_start, organism_end);
+					work.work[live_organisms_processed] +=
+						population_ptr->update_fitness(organism_start, organism_end, lineage);
+					phase_timer.lap(update_fitness_phase);
 
 					/*
 						Search for resources
@@ -241,8 +531,9 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						Reads existence and position of every resource so conflicts with distribute resources
 						which writes these
 					*/
-					population_ptr->search_for_food(organism_start, organism_end);
-					population_ptr->search_for_water(organism_start, organism_end);
+					work.work[resource_items_scanned] += population_ptr->search_for_food(organism_start, organism_end);
+					work.work[resource_items_scanned] += population_ptr->search_for_water(organism_start, organism_end);
+					phase_timer.lap(search_for_resources_phase);
 
 					/*
 						Think
@@ -250,6 +541,7 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						Parallelizable across population as each organism only reads and writes own data
 					*/
 					population_ptr->think(organism_start, organism_end);
+					phase_timer.lap(think_phase);
 
 					/*
 						Move
@@ -257,6 +549,7 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						Parallelizable across population as each organism only reads and writes own data
 					*/
 					population_ptr->move(organism_start, organism_end);
+					phase_timer.lap(move_phase);
 
 					/*
 						Update sprites
@@ -264,36 +557,243 @@ void GeneticSimulation::Simulation::run_threaded(bool benchmark)
 						Parallelizable across population as each organism only reads and writes own data
 					*/
 					population_ptr->update_sprites(organism_start, organism_end);
+					population_ptr->update_spatial_grid(organism_start, organism_end);
+					phase_timer.lap(update_sprites_phase);
 
 					// signal that drawing of population may now begin
 					draw_population_begin_signal_link.notify();
 
-					// increment timestep counter
+					// increment timestep counter, letting lineage events of the finished timestep be written
 					t++;
+					if (lineage) lineage->set_timestep(t);
 
 					// synchronize at end of timestep
+					wait_timer.start();
 					end_of_timestep_barrier.wait();
+					wait_timer.stop(end_of_timestep_wait);
+					phase_timer.reset();
+					work.timesteps++;
+
+					// record completed timestep in metrics if enabled
+					if (i == 0 && metrics_ptr) {
+						metrics_ptr->record_timestep();
+					}
 				}
 			}
 			// end of thread function
 		));
 	}
 
-	// start main render loop in main thread
-	main_render_loop(draw_resources_begin_signal_link, draw_population_begin_signal_link,
-		draw_done_signal_link, num_simulation_threads, benchmark);
+	// start main render loop in main thread, or headless loop if running without a window
+	if (headless) {
+		main_headless_loop(draw_resources_begin_signal_link, draw_population_begin_signal_link,
+			draw_done_signal_link, num_simulation_threads, benchmark, 
+			benchmark ? config.simulation_benchmark_timesteps : timesteps, timestep_done);
+	}
+	else {
+		main_render_loop(draw_resources_begin_signal_link, draw_population_begin_signal_link,
+			draw_done_signal_link, num_simulation_threads, start_timestep, benchmark);
+	}
 
 	// once main render loop has finished (window was closed) interrupt and join all simulation threads
 	for (auto& t_ptr : simulation_threads) {
 		t_ptr->interrupt();
 		t_ptr->join();
 	}
+
+	// finish writing any checkpoints, genome archives, frames and lineage events, and finish the replay by
+	// writing its index
+	if (checkpoint_writer_ptr) {
+		checkpoint_writer_ptr->wait_until_idle();
+	}
+	if (genome_archive_writer_ptr) {
+		genome_archive_writer_ptr->wait_until_idle();
+	}
+	if (frame_renderer_ptr) {
+		frame_renderer_ptr->wait_until_idle();
+	}
+	replay_recorder_ptr.reset();
+	lineage_log_ptr.reset();
+
+	// report work counters and load imbalance if enabled
+	if (config.work_report) {
+		work_counters.write_report("work_counters_" + to_string(num_simulation_threads) +
+			"_simulation_threads.csv", config.results_path);
+	}
+
+	// report allocations over whole run if tracking is enabled (except when checking allocations)
+	if (allocation_counters_ptr && config.run_mode != 3) {
+		allocation_counters_ptr->print_report({}, work_counters.get_thread(0).timesteps);
+	}
 }
 
-// main render loop for simulation
+// run simulation headless and check that the steady-state timestep loop makes no heap 
+// allocations, returning exit status
+int GeneticSimulation::Simulation::check_allocations()
+{
+	// allocations can only be counted by an instrumented build
+	if (!allocation_counters_ptr) {
+		cerr << "Checking allocations requires a build configured with -DTRACK_ALLOCATIONS=ON\n";
+		return 2;
+	}
+
+	// allocation totals at end of warm-up
+	auto warmup = config.allocation_check_warmup_timesteps;
+	auto steady_state_timesteps = config.allocation_check_timesteps;
+	auto warmup_allocations = allocation_counters_ptr->snapshot();
+
+	// run simulation, recording allocations at end of warm-up
+	cout << "Checking allocations over " << steady_state_timesteps << " timesteps after "
+		<< warmup << " warm-up timesteps\n";
+	run_threaded(false, warmup + steady_state_timesteps, [&](unsigned int t) {
+		if (t == warmup) {
+			warmup_allocations = allocation_counters_ptr->snapshot();
+		}
+	});
+
+	// report steady-state allocations and fail if any occurred
+	auto allocations = allocation_counters_ptr->print_report(warmup_allocations, steady_state_timesteps);
+	if (allocations > 0) {
+		cout << "Allocation check failed: " << allocations << " heap allocations in steady-state loop\n";
+		return 1;
+	}
+	cout << "Allocation check passed: no heap allocations in steady-state loop\n";
+	return 0;
+}
+
+// play back replay in window, or decode and time every frame if headless, returning exit status
+int GeneticSimulation::Simulation::run_replay()
+{
+	// map replay and check that it was recorded with the same pool and area sizes
+	ReplayReader reader(config.replay_play_path);
+	if (!reader.is_open()) return 1;
+	auto& header = reader.get_header();
+	if (header.population_slots != population_ptr->get_max_size() || header.food_slots != food_pool_ptr->get_max_size() ||
+		header.water_slots != water_pool_ptr->get_max_size() || header.area_width != area_ptr->get_size().x ||
+		header.area_height != area_ptr->get_size().y) {
+		cerr << "Replay " << config.replay_play_path << " was recorded with a different area, population or "
+			"resource pool size than the config\n";
+		return 1;
+	}
+	auto frames = reader.get_frames();
+	auto start_frame = min(config.replay_start, frames - 1);
+
+	// if headless, decode every frame in turn and then seek to frames spread over the replay in reverse
+	if (headless) {
+		auto start = steady_clock::now();
+		unsigned long long objects = 0;
+		reader.seek(start_frame);
+		auto first_timestep = reader.get_timestep();
+		do {
+			for (auto& o : reader.get_objects()) objects += o.exists;
+		} while (reader.next());
+		if (reader.get_frame() + 1 != frames) return 1;
+		auto decode_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+		auto last_timestep = reader.get_timestep();
+		unsigned int seeks = min(frames, 100u);
+		start = steady_clock::now();
+		for (unsigned int i = seeks; i-- > 0;) {
+			if (!reader.seek(static_cast<unsigned int>(static_cast<unsigned long long>(frames - 1) * i / seeks))) return 1;
+		}
+		auto seek_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+		auto decoded = frames - start_frame;
+		cout << "Decoded " << decoded << " frames of " << config.replay_play_path << " (timesteps "
+			<< first_timestep << " to " << last_timestep << ", mean " << objects / decoded << " objects) in " << decode_us / 1000.0
+			<< " ms (" << std::fixed << std::setprecision(0) << decoded / max(1e-6, decode_us / 1e6)
+			<< " frames/s), mean seek " << std::setprecision(1) << static_cast<double>(seek_us) / seeks << " us\n";
+		return 0;
+	}
+
+	// temperatures are computed for the two rows annotated rather than precomputed for every timestep
+	TemperatureModel temperature_model(config);
+	// playback position in frames, speed in frames per drawn frame and whether paused
+	double position = start_frame;
+	double speed = config.replay_speed;
+	bool paused = false;
+	auto key_pressed = [&](sf::Keyboard::Key key) {
+		switch (key) {
+		case sf::Keyboard::Space:
+			paused = !paused;
+			break;
+		case sf::Keyboard::Period:
+			speed = min(1024.0, speed * 2);
+			break;
+		case sf::Keyboard::Comma:
+			speed = max(1.0 / 64, speed / 2);
+			break;
+		case sf::Keyboard::Home:
+			position = 0;
+			break;
+		case sf::Keyboard::PageUp:
+			position = max(0.0, position - header.keyframe_interval);
+			break;
+		case sf::Keyboard::PageDown:
+			position = min(frames - 1.0, position + header.keyframe_interval);
+			break;
+		default:
+			break;
+		}
+	};
+
+	// draw frames through the pools and population, advancing by the playback speed each frame
+	enable_spatial_grids();
+	while (window.isOpen()) {
+		handle_events(true, key_pressed);
+		if (!reader.seek(static_cast<unsigned int>(position))) return 1;
+		show_replay_frame(reader);
+
+		window.clear(sf::Color(config.background_color));
+		water_pool_ptr->draw(*area_ptr);
+		food_pool_ptr->draw(*area_ptr);
+		population_ptr->draw(*area_ptr);
+		auto viewport_origin = area_ptr->get_viewport_origin();
+		auto lower_y = max(0u, min(area_ptr->get_size().y - 1u,
+			viewport_origin.y + static_cast<int>(area_ptr->get_viewport_size().y) - 1u));
+		area_ptr->draw_annotations(reader.get_timestep(),
+			static_cast<float>(temperature_model.get_temperature(viewport_origin.y, reader.get_timestep())),
+			static_cast<float>(temperature_model.get_temperature(lower_y, reader.get_timestep())));
+		window.display();
+
+		// hold the last frame once the end of the replay is reached
+		if (!paused) position = min(frames - 1.0, position + speed);
+	}
+	return 0;
+}
+
+// show objects of current replay frame in population and resource pools
+void GeneticSimulation::Simulation::show_replay_frame(const ReplayReader& reader)
+{
+	auto& objects = reader.get_objects();
+	size_t i = 0;
+	for (unsigned int j = 0; j < population_ptr->get_max_size(); j++, i++) {
+		auto& o = objects[i];
+		auto& organism = (*population_ptr)[j];
+		organism.set_replay_state(o.exists != 0, reader.get_position(o), reader.get_size(o), true);
+		if (o.exists) organism.set_replay_colors(o.color / 255.f, o.outline ? (o.outline - 1) / 254.f : -1.f);
+	}
+	for (auto pool : { food_pool_ptr.get(), water_pool_ptr.get() }) {
+		for (unsigned int j = 0; j < pool->get_max_size(); j++, i++) {
+			auto& o = objects[i];
+			(*pool)[j].set_replay_state(o.exists != 0, reader.get_position(o), reader.get_size(o), false);
+		}
+	}
+	population_ptr->update_spatial_grid(0, population_ptr->get_max_size());
+	food_pool_ptr->update_spatial_grid(0, food_pool_ptr->get_max_size());
+	water_pool_ptr->update_spatial_grid(0, water_pool_ptr->get_max_size());
+}
+
+// enable spatial grids of the population and resource pools for finding objects near the viewport
+void GeneticSimulation::Simulation::enable_spatial_grids()
+{
+	population_ptr->enable_spatial_grid(area_ptr->get_size());
+	food_pool_ptr->enable_spatial_grid(area_ptr->get_size());
+	water_pool_ptr->enable_spatial_grid(area_ptr->get_size());
+}
+
+// main render loop for simulation, starting from the given timestep
 void GeneticSimulation::Simulation::main_render_loop(SignalLink& draw_resources_begin_signal_link, 
 	SignalLink& draw_population_begin_signal_link, SignalLink& draw_done_signal_link,
-	unsigned int num_simulation_threads, bool benchmark)
+	unsigned int num_simulation_threads, unsigned int start_timestep, bool benchmark)
 {
 	// timestep counter
 	unsigned int t = 0;
@@ -353,19 +853,20 @@ void GeneticSimulation::Simulation::main_render_loop(SignalLink& draw_resources_
 		draw_resources_begin_signal_link.wait();
 		// draw food and water
 		if (draw) {
-			water_pool_ptr->draw();
-			food_pool_ptr->draw();
+			water_pool_ptr->draw(*area_ptr);
+			food_pool_ptr->draw(*area_ptr);
 		}
 		// wait until population can be drawn
 		draw_population_begin_signal_link.wait();
 		// draw population, overlay info annotations and display
 		if (draw) {
-			population_ptr->draw();
+			population_ptr->draw(*area_ptr);
 			auto viewport_origin = area_ptr->get_viewport_origin();
-			auto upper_temperature = planet_ptr->get_temperature(viewport_origin.y, t % config.orbital_period);
-			auto lower_temperature = planet_ptr->get_temperature(max(0u, min(area_ptr->get_size().y - 1u,
-				viewport_origin.y + static_cast<int>(area_ptr->get_viewport_size().y) - 1u)), t % config.orbital_period);
-			area_ptr->draw_annotations(t, upper_temperature, lower_temperature);
+			auto temperatures = population_ptr->get_temperature_row(start_timestep + t);
+			auto upper_temperature = temperatures[viewport_origin.y];
+			auto lower_temperature = temperatures[max(0u, min(area_ptr->get_size().y - 1u,
+				viewport_origin.y + static_cast<int>(area_ptr->get_viewport_size().y) - 1u))];
+			area_ptr->draw_annotations(start_timestep + t, upper_temperature, lower_temperature);
 			window.display();
 		}
 		// signal that iteration is done
@@ -389,6 +890,57 @@ void GeneticSimulation::Simulation::main_render_loop(SignalLink& draw_resources_
 	}
 }
 
+// main loop for simulation without a window, which synchronizes with simulation threads
+// for the given number of timesteps (0 = unlimited) and calls the given function after each
+void GeneticSimulation::Simulation::main_headless_loop(SignalLink& draw_resources_begin_signal_link,
+	SignalLink& draw_population_begin_signal_link, SignalLink& draw_done_signal_link,
+	unsigned int num_simulation_threads, bool benchmark, unsigned int timesteps,
+	const function<void(unsigned int)>& timestep_done)
+{
+	// time points for timing timesteps
+	steady_clock::time_point start, end;
+
+	// record of timestep times for benchmarking
+	vector<unsigned long long> timestep_times;
+	// allocate space for timestep times if benchmarking
+	if (benchmark) {
+		timestep_times.resize(timesteps);
+	}
+
+	// synchronize with simulation threads once per timestep
+	for (unsigned int t = 0; timesteps == 0 || t < timesteps; t++) {
+		// start timing timestep
+		start = steady_clock::now();
+
+		// wait until simulation threads have finished with resources and population
+		draw_resources_begin_signal_link.wait();
+		draw_population_begin_signal_link.wait();
+
+		// call function for completed timestep before simulation threads may distribute
+		// resources, replicate or update fitness in the next timestep
+		if (timestep_done) {
+			timestep_done(t + 1);
+		}
+
+		// signal that iteration is done
+		draw_done_signal_link.notify();
+
+		// record timestep time if benchmarking
+		end = steady_clock::now();
+		if (benchmark) {
+			timestep_times[t] = duration_cast<microseconds>(end - start).count();
+		}
+	}
+
+	// write benchmark results
+	if (benchmark) {
+		write_benchmark_results(timestep_times,
+			"timestep_microseconds_" + to_string(num_simulation_threads) + "_simulation_threads",
+			"benchmark_results_headless_" + to_string(num_simulation_threads) + "_simulation_threads.csv",
+			config.results_path);
+	}
+}
+
 // calculate whether to draw current frame
 inline bool GeneticSimulation::Simulation::calculate_draw(unsigned int timestep, bool limit_framerate,
 	unsigned long long frame_sum_us, unsigned int frame_count, unsigned int target_framerate)
@@ -403,8 +955,9 @@ inline bool GeneticSimulation::Simulation::calculate_draw(unsigned int timestep,
 	return timestep % draw_every == 0;
 }
 
-// handle keypresses and window closure
-void GeneticSimulation::Simulation::handle_events(bool allow_framerate_toggle)
+// handle keypresses and window closure, calling the given function with any other key pressed
+void GeneticSimulation::Simulation::handle_events(bool allow_framerate_toggle,
+	const function<void(sf::Keyboard::Key)>& key_pressed)
 {
 	// pan / zoom viewport if relevant key is pressed
 	if (area_ptr->get_limit_frame_rate()) {
@@ -438,9 +991,126 @@ void GeneticSimulation::Simulation::handle_events(bool allow_framerate_toggle)
 			if (event.key.code == sf::Keyboard::F && allow_framerate_toggle) {
 				area_ptr->toggle_limit_frame_rate();
 			}
+			else if (event.key.code == sf::Keyboard::M) {
+				print_memory_report();
+			}
+			else if (event.key.code == sf::Keyboard::C) {
+				// checkpoint is written by simulation threads at the end of the current timestep
+				checkpoint_requested = true;
+			}
+			else if (key_pressed) {
+				key_pressed(event.key.code);
+			}
 			break;
 		default:
 			break;
 		}
 	}
-}
\ No newline at end of file
+}
+
+// print measured memory footprint alongside estimate and resident set size
+void GeneticSimulation::Simulation::print_memory_report()
+{
+	auto estimate = estimate_memory_footprint(config);
+	measure_memory_footprint().print(cout, "measured", &estimate, "estimated");
+	cout << "  " << std::left << std::setw(26) << "resident set size" << std::right << std::setw(14)
+		<< std::fixed << std::setprecision(3) << get_resident_set_size() / (1024.0 * 1024.0) << "\n"
+		<< std::defaultfloat << std::setprecision(6);
+}
+
+// write full simulation state to a checkpoint (should only be called while no
+// simulation thread is running)
+void GeneticSimulation::Simulation::write_checkpoint(CheckpointWriter& writer)
+{
+	// config the checkpoint must be restored with
+	for (auto value : { config.area_width, config.area_height, config.population_size,
+		config.food_pool_size, config.water_pool_size }) {
+		writer.write<uint32_t>(value);
+	}
+
+	// timestep and random number generator of each simulation thread
+	writer.write<uint32_t>(timestep);
+	writer.write<uint32_t>(static_cast<uint32_t>(simulation_rngs.size()));
+	for (auto& rng : simulation_rngs) {
+		std::ostringstream rng_state;
+		rng_state << rng;
+		writer.write_string(rng_state.str());
+	}
+
+	// resources and organisms
+	food_pool_ptr->write_checkpoint(writer);
+	water_pool_ptr->write_checkpoint(writer);
+	population_ptr->write_checkpoint(writer);
+}
+
+// take a snapshot of full simulation state and submit it to be written in the background
+// (should only be called while no simulation thread is running), returning whether 
+// successful or false if the previous snapshots are still being written
+bool GeneticSimulation::Simulation::snapshot_checkpoint()
+{
+	// skip checkpoint rather than stall simulation if writing cannot keep up
+	auto buffer = checkpoint_writer_ptr->acquire_buffer();
+	if (!buffer) {
+		cerr << "Skipping checkpoint at timestep " << timestep << ": previous checkpoints are still being written\n";
+		return false;
+	}
+	auto start = steady_clock::now();
+	write_checkpoint(*buffer);
+	checkpoint_writer_ptr->submit(buffer, timestep,
+		duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0);
+	return true;
+}
+
+// restore full simulation state from checkpoint file written with the same config, 
+// returning whether successful
+bool GeneticSimulation::Simulation::restore_checkpoint(const string& path)
+{
+	auto start = steady_clock::now();
+	vector<char> data;
+	if (!read_checkpoint_file(path, data)) return false;
+
+	try {
+		CheckpointReader reader(data.data(), data.size());
+
+		// check checkpoint was written with the same config
+		for (auto value : { config.area_width, config.area_height, config.population_size,
+			config.food_pool_size, config.water_pool_size }) {
+			if (reader.read<uint32_t>() != value) {
+				throw std::runtime_error("checkpoint area or pool sizes do not match config");
+			}
+		}
+
+		// timestep and random number generator of each simulation thread, which are only
+		// restored if the number of simulation threads matches
+		reader.read(timestep);
+		auto num_rngs = reader.read<uint32_t>();
+		if (num_rngs != simulation_rngs.size()) {
+			cerr << "Checkpoint was written with " << num_rngs << " simulation threads, so random "
+				"number generators will not be restored\n";
+		}
+		for (unsigned int i = 0; i < num_rngs; i++) {
+			auto rng_state = reader.read_string();
+			if (num_rngs == simulation_rngs.size()) {
+				std::istringstream(rng_state) >> simulation_rngs[i];
+			}
+		}
+
+		// resources and organisms
+		food_pool_ptr->read_checkpoint(reader);
+		water_pool_ptr->read_checkpoint(reader);
+		population_ptr->read_checkpoint(reader);
+
+		if (!reader.at_end()) {
+			throw std::runtime_error("checkpoint has unexpected trailing data");
+		}
+	}
+	catch (const std::runtime_error& e) {
+		cerr << "Restoring checkpoint " << path << " failed: " << e.what() << "\n";
+		return false;
+	}
+
+	cout << "Restored checkpoint " << path << " at timestep " << timestep << " ("
+		<< data.size() / 1024 << " KiB in "
+		<< duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0 << " ms)\n";
+	return true;
+}
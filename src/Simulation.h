@@ -5,8 +5,25 @@
 #include "ConsumableResourcePool.h"
 #include "Population.h"
 #include "Config.h"
+#include "SimulationMetrics.h"
+#include "TelemetryWriter.h"
+#include "GenomeArchiveWriter.h"
+#include "ReplayRecorder.h"
+#include "ReplayReader.h"
+#include "FrameRenderer.h"
+#include "LineageLog.h"
+#include "AllocationCounters.h"
 #include "helper/SignalLink.h"
+#include "helper/MetricsServer.h"
+#include "helper/MemoryFootprint.h"
+#include "helper/Checkpoint.h"
+#include "helper/AsyncCheckpointWriter.h"
 #include <memory>
+#include <functional>
+#include <random>
+#include <vector>
+#include <string>
+#include <atomic>
 #include <SFML/Graphics.hpp>
 
 namespace GeneticSimulation
@@ -16,42 +33,108 @@ namespace GeneticSimulation
 	{
 	public:
 
-		// constructor
-		explicit Simulation(const Config& config);
+		// constructor which optionally takes a planet with temperatures already precomputed for the
+		// config, which is only read and so may be shared with other simulations
+		explicit Simulation(const Config& config, std::shared_ptr<Planet> planet = nullptr);
 
 		// initialize simulation by creating and initializing the necessary components
 		void init();
 
-		// run task based on run mode in config
-		void run();
+		// run task based on run mode in config, returning exit status
+		int run();
+
+		// estimate memory footprint of simulation components from config without allocating them
+		static MemoryFootprint estimate_memory_footprint(const Config& config);
+
+		// measure memory footprint of initialized simulation components
+		MemoryFootprint measure_memory_footprint();
+
+		// run simulation headless for the given number of timesteps, calling the given function with
+		// the population after each timestep while no simulation thread is updating existence,
+		// fitness or phenotypes
+		void run_headless(unsigned int timesteps, 
+			const std::function<void(unsigned int, const Population&)>& timestep_done);
 
 	private:
 
-		// run simulation using at least 1 simulation thread and 1 render thread
-		void run_threaded(bool benchmark = false);
+		// run simulation using at least 1 simulation thread and 1 render thread, or if headless 
+		// the main thread, for the given number of timesteps (0 = unlimited, ignored if not headless)
+		// and calling the given function after each timestep if headless
+		void run_threaded(bool benchmark = false, unsigned int timesteps = 0,
+			const std::function<void(unsigned int)>& timestep_done = nullptr);
 
-		// main render loop for simulation
+		// run simulation headless and check that the steady-state timestep loop makes no heap 
+		// allocations, returning exit status
+		int check_allocations();
+
+		// main render loop for simulation, starting from the given timestep
 		void main_render_loop(SignalLink& draw_resources_begin_signal_link,
 			SignalLink& draw_population_begin_signal_link, 
-			SignalLink& draw_done_signal_link, unsigned int simulation_threads, bool benchmark = false);
+			SignalLink& draw_done_signal_link, unsigned int simulation_threads, unsigned int start_timestep,
+			bool benchmark = false);
+
+		// main loop for simulation without a window, which synchronizes with simulation threads
+		// for the given number of timesteps (0 = unlimited) and calls the given function after each
+		void main_headless_loop(SignalLink& draw_resources_begin_signal_link,
+			SignalLink& draw_population_begin_signal_link, SignalLink& draw_done_signal_link,
+			unsigned int simulation_threads, bool benchmark, unsigned int timesteps,
+			const std::function<void(unsigned int)>& timestep_done);
 
 		// calculate whether to draw current frame
 		inline bool calculate_draw(unsigned int timestep, bool limit_framerate,
 			unsigned long long frame_sum, unsigned int frame_count, unsigned int target_framerate);
 
-		// handle keypresses and window closure
-		void handle_events(bool allow_framerate_toggle = true);
+		// handle keypresses and window closure, calling the given function with any other key pressed
+		void handle_events(bool allow_framerate_toggle = true,
+			const std::function<void(sf::Keyboard::Key)>& key_pressed = nullptr);
+
+		// play back replay in window, or decode and time every frame if headless, returning exit status
+		int run_replay();
+
+		// show objects of current replay frame in population and resource pools
+		void show_replay_frame(const ReplayReader& reader);
+
+		// enable spatial grids of the population and resource pools for finding objects near the viewport
+		void enable_spatial_grids();
+
+		// print measured memory footprint alongside estimate and resident set size
+		void print_memory_report();
+
+		// write full simulation state to a checkpoint (should only be called while no
+		// simulation thread is running)
+		void write_checkpoint(CheckpointWriter& writer);
+
+		// take a snapshot of full simulation state and submit it to be written in the background
+		// (should only be called while no simulation thread is running), returning whether 
+		// successful or false if the previous snapshots are still being written
+		bool snapshot_checkpoint();
+
+		// restore full simulation state from checkpoint file written with the same config, 
+		// returning whether successful
+		bool restore_checkpoint(const std::string& path);
 	
 		// whether components have been initialized
 		bool initialized;
+		// whether running without a window
+		bool headless;
+		// number of simulation threads
+		unsigned int num_simulation_threads;
+		// random number generator for each simulation thread
+		std::vector<std::default_random_engine> simulation_rngs;
+		// timestep simulation threads start from, and are at between timesteps
+		unsigned int timestep;
+		// whether a checkpoint should be written at the end of the current timestep
+		std::atomic<bool> checkpoint_requested;
+		// Pointer to writer of checkpoints in the background (null if checkpoints cannot be requested)
+		std::unique_ptr<AsyncCheckpointWriter> checkpoint_writer_ptr;
 		// graphical window
 		sf::RenderWindow window;
 		// event
 		sf::Event event;
 		// font
 		sf::Font font;
-		// Pointer to planet
-		std::unique_ptr<Planet> planet_ptr;
+		// Pointer to planet (possibly shared with other simulations)
+		std::shared_ptr<Planet> planet_ptr;
 		// Pointer to simulation area
 		std::unique_ptr<SimulationArea> area_ptr;
 		// Pointer to food resource pool
@@ -60,6 +143,22 @@ namespace GeneticSimulation
 		std::unique_ptr<ConsumableResourcePool> water_pool_ptr;
 		// Pointer to population
 		std::unique_ptr<Population> population_ptr;
+		// Pointer to live metrics (null if disabled)
+		std::unique_ptr<SimulationMetrics> metrics_ptr;
+		// Pointer to server exposing live metrics (null if disabled)
+		std::unique_ptr<MetricsServer> metrics_server_ptr;
+		// Pointer to writer of population telemetry (null if disabled)
+		std::unique_ptr<TelemetryWriter> telemetry_writer_ptr;
+		// Pointer to writer of genome archives (null if disabled)
+		std::unique_ptr<GenomeArchiveWriter> genome_archive_writer_ptr;
+		// Pointer to recorder of replay (null if disabled)
+		std::unique_ptr<ReplayRecorder> replay_recorder_ptr;
+		// Pointer to offscreen renderer of frames (null if disabled)
+		std::unique_ptr<FrameRenderer> frame_renderer_ptr;
+		// Pointer to log of births, deaths and gene transfers (null if disabled)
+		std::unique_ptr<LineageLog> lineage_log_ptr;
+		// Pointer to per-phase heap allocation counters (null if allocation tracking is disabled)
+		std::unique_ptr<AllocationCounters> allocation_counters_ptr;
 		// Reference to config
 		const Config& config;
 	};
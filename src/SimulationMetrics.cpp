@@ -0,0 +1,99 @@
+#include "SimulationMetrics.h"
+#include "helper/memory_usage.h"
+#include <string>
+#include <chrono>
+
+using std::string;
+using std::to_string;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::memory_order_relaxed;
+
+using namespace GeneticSimulation;
+
+// append a single-valued metric with its type to a Prometheus text page
+static void render_metric(string& out, const string& name, const string& type, const string& value)
+{
+	out += "# TYPE " + name + " " + type + "\n";
+	out += name + " " + value + "\n";
+}
+
+// constructor which takes the population whose counters are reported
+GeneticSimulation::SimulationMetrics::SimulationMetrics(const Population& population) :
+	population(population), timesteps(0), last_render_timesteps(0),
+	last_render_time(steady_clock::now()) {}
+
+// record completion of a timestep
+void GeneticSimulation::SimulationMetrics::record_timestep()
+{
+	timesteps.fetch_add(1, memory_order_relaxed);
+}
+
+// record the duration of a phase in microseconds
+void GeneticSimulation::SimulationMetrics::record_phase(simulation_phase p, unsigned long long microseconds)
+{
+	phase_latencies[p].record(microseconds);
+}
+
+// set memory footprint to report per component (should be set before rendering begins)
+void GeneticSimulation::SimulationMetrics::set_memory_footprint(const MemoryFootprint& footprint)
+{
+	memory_footprint = footprint;
+}
+
+// render all metrics (not thread-safe, so should only be called by one thread)
+string GeneticSimulation::SimulationMetrics::render()
+{
+	// calculate timestep rate since previous render
+	auto now = steady_clock::now();
+	auto current_timesteps = timesteps.load(memory_order_relaxed);
+	double elapsed = duration<double>(now - last_render_time).count();
+	double timesteps_per_second = elapsed > 0 ?
+		(current_timesteps - last_render_timesteps) / elapsed : 0;
+	last_render_timesteps = current_timesteps;
+	last_render_time = now;
+
+	// get population counters
+	auto& counters = population.get_counters();
+
+	// render counters and gauges
+	string out;
+	render_metric(out, "genetic_simulation_timesteps_total", "counter", to_string(current_timesteps));
+	render_metric(out, "genetic_simulation_timesteps_per_second", "gauge", to_string(timesteps_per_second));
+	render_metric(out, "genetic_simulation_alive_organisms", "gauge",
+		to_string(counters.alive.load(memory_order_relaxed)));
+	render_metric(out, "genetic_simulation_births_total", "counter",
+		to_string(counters.births.load(memory_order_relaxed)));
+	render_metric(out, "genetic_simulation_deaths_total", "counter",
+		to_string(counters.deaths.load(memory_order_relaxed)));
+	render_metric(out, "genetic_simulation_gene_transfers_total", "counter",
+		to_string(counters.gene_transfers.load(memory_order_relaxed)));
+	out += "# TYPE genetic_simulation_resources_consumed_total counter\n";
+	out += "genetic_simulation_resources_consumed_total{resource=\"food\"} " +
+		to_string(counters.food_consumed.load(memory_order_relaxed)) + "\n";
+	out += "genetic_simulation_resources_consumed_total{resource=\"water\"} " +
+		to_string(counters.water_consumed.load(memory_order_relaxed)) + "\n";
+	// report size of the phylogeny and birth of the population's common ancestor once there is one
+	auto phylogeny = population.get_phylogeny().summarize();
+	render_metric(out, "genetic_simulation_phylogeny_nodes", "gauge", to_string(phylogeny.nodes));
+	render_metric(out, "genetic_simulation_founder_lineages", "gauge", to_string(phylogeny.founder_lineages));
+	if (phylogeny.has_common_ancestor) {
+		render_metric(out, "genetic_simulation_common_ancestor_birth_timestep", "gauge",
+			to_string(phylogeny.common_ancestor.birth_timestep));
+	}
+	render_metric(out, "genetic_simulation_resident_memory_bytes", "gauge",
+		to_string(get_resident_set_size()));
+	out += "# TYPE genetic_simulation_memory_bytes gauge\n";
+	for (auto& c : memory_footprint.get_components()) {
+		out += "genetic_simulation_memory_bytes{component=\"" + c.first + "\"} " + to_string(c.second) + "\n";
+	}
+
+	// render phase latency histograms
+	out += "# TYPE genetic_simulation_phase_duration_seconds histogram\n";
+	for (unsigned int p = 0; p < num_phases; p++) {
+		phase_latencies[p].render(out, "genetic_simulation_phase_duration_seconds",
+			string("phase=\"") + get_phase_name(static_cast<simulation_phase>(p)) + "\"");
+	}
+
+	return out;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Population.h"
+#include "SimulationPhase.h"
+#include "helper/LatencyHistogram.h"
+#include "helper/MemoryFootprint.h"
+#include <array>
+#include <atomic>
+#include <string>
+#include <chrono>
+
+namespace GeneticSimulation
+{
+	// Live counters, gauges and per-phase latency histograms of a running
+	// simulation, which are rendered in the Prometheus text exposition format
+	class SimulationMetrics
+	{
+	public:
+
+		// constructor which takes the population whose counters are reported
+		explicit SimulationMetrics(const Population& population);
+
+		// record completion of a timestep
+		void record_timestep();
+
+		// record the duration of a phase in microseconds
+		void record_phase(simulation_phase p, unsigned long long microseconds);
+
+		// set memory footprint to report per component (should be set before rendering begins)
+		void set_memory_footprint(const MemoryFootprint& footprint);
+
+		// render all metrics (not thread-safe, so should only be called by one thread)
+		std::string render();
+
+	private:
+
+		// reference to population whose counters are reported
+		const Population& population;
+		// number of completed timesteps
+		std::atomic<unsigned long long> timesteps;
+		// memory footprint measured after initialization
+		MemoryFootprint memory_footprint;
+		// latency histogram for each phase
+		std::array<LatencyHistogram, num_phases> phase_latencies;
+		// timestep count and time of previous render, used for calculating timestep rate
+		unsigned long long last_render_timesteps;
+		std::chrono::steady_clock::time_point last_render_time;
+	};
+}
\ No newline at end of file
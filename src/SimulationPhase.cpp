@@ -0,0 +1,19 @@
+#include "SimulationPhase.h"
+
+// get name of a phase
+const char* GeneticSimulation::get_phase_name(simulation_phase p)
+{
+	switch (p) {
+	case interact_phase: return "interact";
+	case react_to_temperature_phase: return "react_to_temperature";
+	case distribute_resources_phase: return "distribute_resources";
+	case replicate_phase: return "replicate";
+	case update_phenotypes_phase: return "update_phenotypes";
+	case update_fitness_phase: return "update_fitness";
+	case search_for_resources_phase: return "search_for_resources";
+	case think_phase: return "think";
+	case move_phase: return "move";
+	case update_sprites_phase: return "update_sprites";
+	default: return "unknown";
+	}
+}
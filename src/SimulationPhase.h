@@ -0,0 +1,15 @@
+#pragma once
+
+namespace GeneticSimulation
+{
+	// phases of a simulation timestep
+	enum simulation_phase {
+		interact_phase, react_to_temperature_phase, distribute_resources_phase,
+		replicate_phase, update_phenotypes_phase, update_fitness_phase,
+		search_for_resources_phase, think_phase, move_phase, update_sprites_phase,
+		num_phases
+	};
+
+	// get name of a phase
+	const char* get_phase_name(simulation_phase p);
+}
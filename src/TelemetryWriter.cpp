@@ -0,0 +1,222 @@
+#include "TelemetryWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+using std::string;
+using std::size_t;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::memory_order_relaxed;
+
+using namespace GeneticSimulation;
+
+// name, type and position in record of a column
+struct TelemetryColumn
+{
+	const char* name;
+	uint8_t type;
+	size_t offset;
+};
+
+// column types
+static const uint8_t uint64_column = 0;
+static const uint8_t float64_column = 1;
+
+// columns of telemetry file, in order
+#define TELEMETRY_COLUMN(name, type) { #name, type, offsetof(TelemetryRecord, name) }
+static const TelemetryColumn telemetry_columns[] = {
+	TELEMETRY_COLUMN(timestep, uint64_column),
+	TELEMETRY_COLUMN(alive, uint64_column),
+	TELEMETRY_COLUMN(births, uint64_column),
+	TELEMETRY_COLUMN(deaths, uint64_column),
+	TELEMETRY_COLUMN(gene_transfers, uint64_column),
+	TELEMETRY_COLUMN(food_consumed, uint64_column),
+	TELEMETRY_COLUMN(water_consumed, uint64_column),
+	TELEMETRY_COLUMN(food_items, uint64_column),
+	TELEMETRY_COLUMN(water_items, uint64_column),
+	TELEMETRY_COLUMN(food_stock, float64_column),
+	TELEMETRY_COLUMN(water_stock, float64_column),
+	TELEMETRY_COLUMN(fitness_min, float64_column),
+	TELEMETRY_COLUMN(fitness_p25, float64_column),
+	TELEMETRY_COLUMN(fitness_median, float64_column),
+	TELEMETRY_COLUMN(fitness_p75, float64_column),
+	TELEMETRY_COLUMN(fitness_max, float64_column),
+	TELEMETRY_COLUMN(mean_fitness, float64_column),
+	TELEMETRY_COLUMN(mean_area_of_influence, float64_column),
+	TELEMETRY_COLUMN(mean_speed, float64_column),
+	TELEMETRY_COLUMN(mean_health_rate, float64_column),
+	TELEMETRY_COLUMN(mean_ideal_temp, float64_column),
+	TELEMETRY_COLUMN(mean_temp_range, float64_column),
+};
+#undef TELEMETRY_COLUMN
+static const uint32_t num_telemetry_columns = sizeof(telemetry_columns) / sizeof(telemetry_columns[0]);
+
+// identifier and format version of telemetry files
+static const char telemetry_magic[8] = "GSTELEM";
+static const uint32_t telemetry_version = 1;
+
+// write a value to a stream as raw bytes
+template<class T>
+static void write_value(std::ostream& out, const T& value)
+{
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// count existing items in a resource pool and sum their values
+static void measure_stock(const ConsumableResourcePool& pool, uint64_t& items, double& stock)
+{
+	items = 0;
+	stock = 0;
+	for (unsigned int i = 0; i < pool.get_max_size(); i++) {
+		if (pool[i].get_exists()) {
+			items++;
+			stock += pool[i].get_value();
+		}
+	}
+}
+
+// constructor which takes the file path, minimum queue capacity, rows per chunk and
+// maximum number of organisms
+GeneticSimulation::TelemetryWriter::TelemetryWriter(const string& path, unsigned int queue_capacity,
+	unsigned int chunk_rows, unsigned int max_organisms) :
+	path(path), chunk_rows(chunk_rows), queue(queue_capacity), dropped(0), stop(false)
+{
+	fitness.reserve(max_organisms);
+	file.open(path, ios::binary | ios::trunc);
+	if (!file) {
+		cerr << "Opening telemetry file " << path << " failed: Check that the path exists and may be written to\n";
+		return;
+	}
+	write_header();
+	chunk.reserve(chunk_rows);
+	column.resize(static_cast<size_t>(chunk_rows) * sizeof(uint64_t));
+	writer_thread = std::thread([this] { run(); });
+}
+
+// destructor which writes all queued records and stops the thread
+GeneticSimulation::TelemetryWriter::~TelemetryWriter()
+{
+	if (!writer_thread.joinable()) return;
+	stop = true;
+	writer_thread.join();
+	cout << "Wrote telemetry to " << path;
+	if (dropped > 0) {
+		cout << " (" << dropped << " records dropped as writing could not keep up)";
+	}
+	cout << "\n";
+}
+
+// get whether file was opened
+bool GeneticSimulation::TelemetryWriter::is_open() const
+{
+	return writer_thread.joinable();
+}
+
+// record statistics at a timestep without blocking or allocating (should only be called by
+// one thread at a time while no simulation thread is updating organisms or resources)
+void GeneticSimulation::TelemetryWriter::record(unsigned int timestep, const Population& population,
+	const ConsumableResourcePool& food, const ConsumableResourcePool& water)
+{
+	TelemetryRecord record = {};
+	record.timestep = timestep;
+
+	// running totals of population events
+	auto& counters = population.get_counters();
+	record.births = counters.births.load(memory_order_relaxed);
+	record.deaths = counters.deaths.load(memory_order_relaxed);
+	record.gene_transfers = counters.gene_transfers.load(memory_order_relaxed);
+	record.food_consumed = counters.food_consumed.load(memory_order_relaxed);
+	record.water_consumed = counters.water_consumed.load(memory_order_relaxed);
+
+	// resources remaining
+	measure_stock(food, record.food_items, record.food_stock);
+	measure_stock(water, record.water_items, record.water_stock);
+
+	// means of live organisms
+	auto summary = population.summarize();
+	record.alive = summary.alive;
+	record.mean_fitness = summary.mean_fitness;
+	record.mean_area_of_influence = summary.mean_area_of_influence;
+	record.mean_speed = summary.mean_speed;
+	record.mean_health_rate = summary.mean_health_rate;
+	record.mean_ideal_temp = summary.mean_ideal_temp;
+	record.mean_temp_range = summary.mean_temp_range;
+
+	// fitness quantiles of live organisms (left at 0 if the population has died out)
+	fitness.clear();
+	for (unsigned int i = 0; i < population.get_max_size(); i++) {
+		if (population[i].get_exists()) {
+			fitness.push_back(population[i].get_fitness());
+		}
+	}
+	if (!fitness.empty()) {
+		std::sort(fitness.begin(), fitness.end());
+		auto quantile = [&](double q) { return fitness[static_cast<size_t>(q * (fitness.size() - 1) + 0.5)]; };
+		record.fitness_min = fitness.front();
+		record.fitness_p25 = quantile(0.25);
+		record.fitness_median = quantile(0.5);
+		record.fitness_p75 = quantile(0.75);
+		record.fitness_max = fitness.back();
+	}
+
+	// queue record for writer thread, dropping it rather than waiting if the queue is full
+	if (!queue.try_push(record)) {
+		dropped.fetch_add(1, memory_order_relaxed);
+	}
+}
+
+// drain queue into chunks until stopped
+void GeneticSimulation::TelemetryWriter::run()
+{
+	TelemetryRecord record;
+	while (true) {
+		// read stop flag before draining so that records queued before stopping are written
+		bool stopping = stop;
+		while (queue.try_pop(record)) {
+			chunk.push_back(record);
+			if (chunk.size() == chunk_rows) write_chunk();
+		}
+		if (stopping) break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	write_chunk();
+	file.close();
+	if (!file) {
+		cerr << "Writing telemetry file " << path << " failed\n";
+	}
+}
+
+// write header describing columns
+void GeneticSimulation::TelemetryWriter::write_header()
+{
+	file.write(telemetry_magic, sizeof(telemetry_magic));
+	write_value(file, telemetry_version);
+	write_value(file, num_telemetry_columns);
+	for (auto& c : telemetry_columns) {
+		write_value(file, c.type);
+		write_value(file, static_cast<uint8_t>(std::strlen(c.name)));
+		file.write(c.name, std::strlen(c.name));
+	}
+}
+
+// write buffered records as a chunk of columns
+void GeneticSimulation::TelemetryWriter::write_chunk()
+{
+	if (chunk.empty()) return;
+	write_value(file, static_cast<uint32_t>(chunk.size()));
+	write_value(file, static_cast<uint32_t>(0));
+	// gather each column's values from records (all columns are 8 bytes wide)
+	for (auto& c : telemetry_columns) {
+		for (size_t row = 0; row < chunk.size(); row++) {
+			std::memcpy(&column[row * sizeof(uint64_t)],
+				reinterpret_cast<const char*>(&chunk[row]) + c.offset, sizeof(uint64_t));
+		}
+		file.write(column.data(), chunk.size() * sizeof(uint64_t));
+	}
+	file.flush();
+	chunk.clear();
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Population.h"
+#include "ConsumableResourcePool.h"
+#include "helper/SpscQueue.h"
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <cstdint>
+
+namespace GeneticSimulation
+{
+	// population and resource statistics at the end of a timestep (event counts are running totals)
+	struct TelemetryRecord
+	{
+		uint64_t timestep;
+		uint64_t alive;
+		uint64_t births;
+		uint64_t deaths;
+		uint64_t gene_transfers;
+		uint64_t food_consumed;
+		uint64_t water_consumed;
+		uint64_t food_items;
+		uint64_t water_items;
+		double food_stock;
+		double water_stock;
+		double fitness_min;
+		double fitness_p25;
+		double fitness_median;
+		double fitness_p75;
+		double fitness_max;
+		double mean_fitness;
+		double mean_area_of_influence;
+		double mean_speed;
+		double mean_health_rate;
+		double mean_ideal_temp;
+		double mean_temp_range;
+	};
+
+	// Records telemetry into a bounded lock-free queue which a background thread drains into
+	// a columnar file, so that recording never blocks on disk (records are dropped if the
+	// queue is full). The file consists of:
+	//   header: magic "GSTELEM\0", uint32 version, uint32 column count, then for each column
+	//           a uint8 type (0 = uint64, 1 = float64), a uint8 name length and the name
+	//   chunks: until end of file, a uint32 row count and uint32 reserved, then for each
+	//           column the values of every row in the chunk
+	// with all values little-endian
+	class TelemetryWriter
+	{
+	public:
+
+		// constructor which takes the file path, minimum queue capacity, rows per chunk and
+		// maximum number of organisms
+		TelemetryWriter(const std::string& path, unsigned int queue_capacity, unsigned int chunk_rows,
+			unsigned int max_organisms);
+
+		// destructor which writes all queued records and stops the thread
+		~TelemetryWriter();
+
+		// get whether file was opened
+		bool is_open() const;
+
+		// record statistics at a timestep without blocking or allocating (should only be called by
+		// one thread at a time while no simulation thread is updating organisms or resources)
+		void record(unsigned int timestep, const Population& population,
+			const ConsumableResourcePool& food, const ConsumableResourcePool& water);
+
+	private:
+
+		// drain queue into chunks until stopped
+		void run();
+
+		// write header describing columns
+		void write_header();
+
+		// write buffered records as a chunk of columns
+		void write_chunk();
+
+		// path of file
+		const std::string path;
+		// rows per chunk
+		const unsigned int chunk_rows;
+		// queue of records from simulation to writer thread
+		SpscQueue<TelemetryRecord> queue;
+		// fitness of live organisms, reused for quantiles at each record
+		std::vector<float> fitness;
+		// number of records dropped as queue was full
+		std::atomic<unsigned long long> dropped;
+		// records buffered for the next chunk and column values of a chunk (writer thread only)
+		std::vector<TelemetryRecord> chunk;
+		std::vector<char> column;
+		// output file
+		std::ofstream file;
+		// whether writer thread should stop once queue is empty
+		std::atomic<bool> stop;
+		// background thread writing records
+		std::thread writer_thread;
+	};
+}
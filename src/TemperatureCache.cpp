@@ -0,0 +1,156 @@
+#include "TemperatureCache.h"
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using std::string;
+using std::size_t;
+using std::cout;
+using std::cerr;
+using std::ios;
+
+// magic bytes and format version identifying cache files (version changes whenever layout changes)
+static const char cache_magic[8] = { 'G', 'S', 'T', 'E', 'M', 'P', 'S', '\0' };
+static const uint32_t cache_version = 1;
+
+// 64-bit FNV-1a hash of the bytes of a value, continuing from a previous hash
+template<class T>
+static uint64_t hash_value(uint64_t hash, const T& value)
+{
+	unsigned char bytes[sizeof(T)];
+	std::memcpy(bytes, &value, sizeof(T));
+	for (auto b : bytes) {
+		hash = (hash ^ b) * 1099511628211ull;
+	}
+	return hash;
+}
+
+// constructor which takes the cache directory and the config and storage of the table
+GeneticSimulation::TemperatureCache::TemperatureCache(const string& directory, const Config& config,
+	temperature_storage storage) : 
+	parameter_hash(hash_parameters(config, storage)), storage(storage),
+	area_height(config.area_height), orbital_period(config.orbital_period)
+{
+	// name file by storage and hash
+	std::ostringstream filename;
+	filename << "temperatures_" << get_temperature_storage_name(storage) << "_" 
+		<< std::hex << std::setw(16) << std::setfill('0') << parameter_hash << ".bin";
+	path = boost::filesystem::path(directory) / filename.str();
+}
+
+// map cached table if present and valid, returning pointer to table (null if not cached)
+// and setting the quantization offset and scale stored with it
+const char* GeneticSimulation::TemperatureCache::map(size_t bytes, double& quantization_offset, double& quantization_scale)
+{
+	namespace fs = boost::filesystem;
+	try {
+		// check file exists and is the expected size
+		if (!fs::exists(path) || fs::file_size(path) != table_offset + bytes) return nullptr;
+		file.open(path.string());
+		if (!file.is_open()) return nullptr;
+
+		// check header matches table
+		Header header;
+		std::memcpy(&header, file.data(), sizeof(Header));
+		auto expected = make_header(bytes);
+		if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+			header.version != expected.version || header.storage != expected.storage ||
+			header.parameter_hash != expected.parameter_hash || header.area_height != expected.area_height ||
+			header.orbital_period != expected.orbital_period || header.table_bytes != expected.table_bytes) {
+			cerr << "Ignoring temperature cache " << path.string() << ": header does not match config\n";
+			file.close();
+			return nullptr;
+		}
+
+		quantization_offset = header.quantization_offset;
+		quantization_scale = header.quantization_scale;
+		cout << "Mapped temperatures from cache " << path.string() << "\n";
+		return file.data() + table_offset;
+	}
+	catch (const std::exception& e) {
+		// if mapping fails, log error and compute temperatures instead
+		cerr << "Mapping temperature cache failed: " << e.what() << "\n";
+		if (file.is_open()) file.close();
+		return nullptr;
+	}
+}
+
+// write table to cache, atomically replacing any existing file
+void GeneticSimulation::TemperatureCache::write(const char* data, size_t bytes, 
+	double quantization_offset, double quantization_scale) const
+{
+	namespace fs = boost::filesystem;
+	try {
+		// write to a uniquely named temporary file so that concurrent writers and readers never see
+		// a partial file, then rename over cache file
+		fs::create_directories(path.parent_path().empty() ? fs::path(".") : path.parent_path());
+		auto temporary_path = path.parent_path() / fs::unique_path(path.filename().string() + ".%%%%%%%%.tmp");
+		{
+			fs::ofstream cache_file(temporary_path, ios::binary | ios::trunc);
+			if (!cache_file) {
+				cerr << "Writing temperature cache failed: Check that the path exists and may be written to\n";
+				return;
+			}
+			auto header = make_header(bytes);
+			header.quantization_offset = quantization_offset;
+			header.quantization_scale = quantization_scale;
+			char padded_header[table_offset] = {};
+			std::memcpy(padded_header, &header, sizeof(Header));
+			cache_file.write(padded_header, table_offset);
+			cache_file.write(data, bytes);
+			if (!cache_file) {
+				cerr << "Writing temperature cache failed\n";
+				cache_file.close();
+				fs::remove(temporary_path);
+				return;
+			}
+		}
+		fs::rename(temporary_path, path);
+		cout << "Wrote temperatures to cache " << path.string() << "\n";
+	}
+	catch (const fs::filesystem_error& e) {
+		// if writing cache fails, log error
+		cerr << "Writing temperature cache failed: " << e.what() << "\n";
+	}
+}
+
+// get number of bytes of table currently mapped
+size_t GeneticSimulation::TemperatureCache::get_mapped_size() const
+{
+	return file.is_open() ? file.size() - table_offset : 0;
+}
+
+// hash format and every option affecting temperatures in a table of the given storage
+uint64_t GeneticSimulation::TemperatureCache::hash_parameters(const Config& config, temperature_storage storage)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (auto value : { static_cast<double>(cache_version), static_cast<double>(storage),
+		static_cast<double>(config.precompute_temperatures_vectorized),
+		static_cast<double>(config.area_height), static_cast<double>(config.orbital_period),
+		config.orbit_center_offset_x, config.orbit_center_offset_y, config.orbit_radius_x,
+		config.orbit_radius_y, config.orbit_rotation, config.star_luminosity, config.albedo,
+		config.axial_tilt, config.radius, config.atmosphere_optical_thickness,
+		config.temperature_moderation_factor, config.temperature_moderation_bias }) {
+		hash = hash_value(hash, value);
+	}
+#ifdef GPU_SUPPORT
+	// temperatures computed on the GPU use lower precision
+	hash = hash_value(hash, config.precompute_temperatures_gpu);
+#endif
+	return hash;
+}
+
+// fill in header fields which identify the table
+GeneticSimulation::TemperatureCache::Header GeneticSimulation::TemperatureCache::make_header(size_t bytes) const
+{
+	Header header{};
+	std::memcpy(header.magic, cache_magic, sizeof(header.magic));
+	header.version = cache_version;
+	header.storage = static_cast<uint32_t>(storage);
+	header.parameter_hash = parameter_hash;
+	header.area_height = area_height;
+	header.orbital_period = orbital_period;
+	header.table_bytes = bytes;
+	return header;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Config.h"
+#include "TemperatureStorage.h"
+#include <cstdint>
+#include <cstddef>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace GeneticSimulation
+{
+	// A file of precomputed temperatures, named by a hash of every option that affects them, 
+	// which is written once and memory-mapped read-only by later runs so that concurrent
+	// processes share the same pages
+	class TemperatureCache
+	{
+	public:
+
+		// constructor which takes the cache directory and the config and storage of the table
+		TemperatureCache(const std::string& directory, const Config& config, temperature_storage storage);
+
+		// map cached table if present and valid, returning pointer to table (null if not cached)
+		// and setting the quantization offset and scale stored with it
+		const char* map(std::size_t bytes, double& quantization_offset, double& quantization_scale);
+
+		// write table to cache, atomically replacing any existing file
+		void write(const char* data, std::size_t bytes, double quantization_offset, double quantization_scale) const;
+
+		// get number of bytes of table currently mapped
+		std::size_t get_mapped_size() const;
+
+		// hash format and every option affecting temperatures in a table of the given storage
+		static uint64_t hash_parameters(const Config& config, temperature_storage storage);
+
+	private:
+
+		// header at start of cache file
+		struct Header
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t storage;
+			uint64_t parameter_hash;
+			uint32_t area_height;
+			uint32_t orbital_period;
+			double quantization_offset;
+			double quantization_scale;
+			uint64_t table_bytes;
+		};
+
+		// offset of table in file, keeping it aligned to a cache line
+		static constexpr std::size_t table_offset = (sizeof(Header) + 63) / 64 * 64;
+
+		// fill in header fields which identify the table
+		Header make_header(std::size_t bytes) const;
+
+		// path to cache file
+		boost::filesystem::path path;
+		// hash of options affecting temperatures
+		uint64_t parameter_hash;
+		// storage and dimensions of table
+		temperature_storage storage;
+		unsigned int area_height;
+		unsigned int orbital_period;
+		// mapped cache file
+		boost::iostreams::mapped_file_source file;
+	};
+}
@@ -0,0 +1,48 @@
+#include "TemperatureKernel.h"
+#include "helper/platform.h"
+#include <cmath>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+// arcsine approximation accurate to single precision, written without branches so that it
+// vectorizes (minimax polynomial on [0, 0.5], and asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)) above)
+static inline float fast_asin(float x)
+{
+	float a = std::fabs(x);
+	float z_large = 0.5f * (1.f - a);
+	float s_large = std::sqrt(z_large);
+	float z_small = a * a;
+	bool large = a > 0.5f;
+	float z = large ? z_large : z_small;
+	float s = large ? s_large : a;
+	float p = ((((4.2163199048e-2f * z + 2.4181311049e-2f) * z + 4.5470025998e-2f) * z
+		+ 7.4953002686e-2f) * z + 1.6666752422e-1f) * z * s + s;
+	float p_large = 1.57079632679489662f - 2.f * p;
+	return std::copysign(large ? p_large : p, x);
+}
+
+// compute temperatures for a run of timesteps at one latitude from terms hoisted out of the loop:
+// equatorial temperature (including greenhouse effect) and tangent, cosine and sine of effective 
+// axial tilt for each timestep, and linear coefficients of the moderated surface factor
+// (vectorized for the widest instruction set available at run time where supported)
+SIMD_TARGET_CLONES
+void GeneticSimulation::compute_temperature_row(const LatitudeTerms& latitude, const float* equatorial_temperatures,
+	const float* tan_tilts, const float* cos_tilts, const float* sin_tilts, unsigned int timesteps,
+	float moderation_slope, float moderation_intercept, float* temperatures)
+{
+	const float tan_latitude = latitude.tan_latitude;
+	const float cos_latitude = latitude.cos_latitude;
+	const float sin_latitude = latitude.sin_latitude;
+	for (unsigned int t = 0; t < timesteps; t++) {
+		// proportion of daylight hours from extra longitude in or out of daylight
+		float plane_dist_radius_ratio = min(1.f, max(-1.f, tan_tilts[t] * tan_latitude));
+		float daylight_proportion = 0.5f + fast_asin(plane_dist_radius_ratio) * 0.318309886183790672f;
+		// radiation strength at effective latitude, using cos(latitude - tilt)
+		float radiation_strength = max(0.f, cos_latitude * cos_tilts[t] + sin_latitude * sin_tilts[t]);
+		// moderated temperature relative to equatorial temperature
+		temperatures[t] = equatorial_temperatures[t] *
+			(moderation_slope * radiation_strength * daylight_proportion + moderation_intercept);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+namespace GeneticSimulation
+{
+	// terms of the temperature formula which depend only on timestep, for a run of timesteps
+	struct TimestepTerms
+	{
+		std::vector<float> equatorial_temperatures;
+		std::vector<float> tan_tilts;
+		std::vector<float> cos_tilts;
+		std::vector<float> sin_tilts;
+	};
+
+	// terms of the temperature formula which depend only on latitude
+	struct LatitudeTerms
+	{
+		float tan_latitude;
+		float cos_latitude;
+		float sin_latitude;
+	};
+
+	// compute temperatures for a run of timesteps at one latitude from terms hoisted out of the loop:
+	// equatorial temperature (including greenhouse effect) and tangent, cosine and sine of effective 
+	// axial tilt for each timestep, and linear coefficients of the moderated surface factor
+	// (vectorized for the widest instruction set available at run time where supported)
+	void compute_temperature_row(const LatitudeTerms& latitude, const float* equatorial_temperatures,
+		const float* tan_tilts, const float* cos_tilts, const float* sin_tilts, unsigned int timesteps,
+		float moderation_slope, float moderation_intercept, float* temperatures);
+}
@@ -0,0 +1,158 @@
+#include "TemperatureModel.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <boost/math/special_functions/sign.hpp>
+
+using std::min;
+using std::max;
+
+// pi
+static const double pi = 3.14159265358979323846;
+
+// constructor which takes planet and area options from config
+GeneticSimulation::TemperatureModel::TemperatureModel(const Config& config) :
+	area_height(config.area_height),
+	orbital_period(config.orbital_period),
+	orbit_center_offset_x(config.orbit_center_offset_x),
+	orbit_center_offset_y(config.orbit_center_offset_y),
+	orbit_radius_x(config.orbit_radius_x),
+	orbit_radius_y(config.orbit_radius_y),
+	orbit_rotation(config.orbit_rotation),
+	star_luminosity(config.star_luminosity),
+	albedo(config.albedo),
+	axial_tilt(config.axial_tilt),
+	radius(config.radius),
+	temperature_moderation_factor(config.temperature_moderation_factor),
+	temperature_moderation_bias(config.temperature_moderation_bias),
+	greenhouse_factor(pow(1 + 0.75 * config.atmosphere_optical_thickness, 0.25)) {}
+
+// get equatorial black body temperature at a timestep
+double GeneticSimulation::TemperatureModel::get_equatorial_temperature(unsigned int t) const
+{
+	// calculate orbital angle corresponding to timestep
+	double angle = (static_cast<double>(t) / static_cast<double>(orbital_period)) * 2 * pi;
+
+	// calculate the x and y coordinates of the planet at this angle in the orbital ellipse
+	double pos_x = (orbit_radius_x * cos(angle) * cos(orbit_rotation)) -
+		(orbit_radius_y * sin(angle) * sin(orbit_rotation)) + orbit_center_offset_x;
+	double pos_y = (orbit_radius_x * cos(angle) * sin(orbit_rotation)) +
+		(orbit_radius_y * sin(angle) * cos(orbit_rotation)) + orbit_center_offset_y;
+	// calculate squared distance from star (0, 0) based on these coordinates
+	double squared_dist = pos_x * pos_x + pos_y * pos_y;
+
+	// calculate equivalent black body temperature based on this squared distance
+	double black_body_temperature = pow((star_luminosity * (1 - albedo)) /
+		(16 * pi * squared_dist * 5.670373e-8), 0.25);
+
+	// calculate an approximated equatorial temperature from the average black body temperature
+	return black_body_temperature / cos(pi / 6.0);
+}
+
+// get effective axial tilt in degrees at a timestep
+double GeneticSimulation::TemperatureModel::get_effective_axial_tilt(unsigned int t) const
+{
+	// calculate orbital angle corresponding to timestep
+	double angle = (static_cast<double>(t) / static_cast<double>(orbital_period)) * 2 * pi;
+	return sin(angle + orbit_rotation) * axial_tilt;
+}
+
+// get latitude in degrees of a y coordinate
+double GeneticSimulation::TemperatureModel::get_latitude(unsigned int y) const
+{
+	return -(((static_cast<double>(y) / static_cast<double>(area_height - 1)) * (90.f - -90.f)) - 90.f);
+}
+
+// get ratio of surface temperature to equatorial temperature at a latitude and effective axial tilt,
+// accounting for daylight hours, radiation strength, moderation and greenhouse effect
+double GeneticSimulation::TemperatureModel::get_surface_factor(double latitude, double effective_axial_tilt) const
+{
+	// calculate effective latitude based on effective axial tilt
+	double effective_latitude = latitude - effective_axial_tilt;
+
+	// calculate the vertical height to the current latitude
+	double height_to_latitude = sin((latitude / 360.0) * 2 * pi) * radius;
+	// calculate distance between axially tilted plane and plane
+	// dividing day and night, travelling along latitude
+	double effective_tilt_plane_dist = tan((effective_axial_tilt / 360.0) * 2 * pi) * height_to_latitude;
+	// calculate the width of the planet at the current latitude
+	double width_at_latitude = max(0., cos((latitude / 360.0) * 2 * pi) * radius);
+	// calculate a safe ratio of the plane distance to the width at latitude
+	double plane_dist_radius_ratio = width_at_latitude == 0 ?
+		boost::math::sign(effective_tilt_plane_dist) :
+		effective_tilt_plane_dist / width_at_latitude;
+	// calculate the extra longitude in or out of daylight
+	double extra_logitude = asin(max(-1.0, (min(1.0, plane_dist_radius_ratio))));
+	// calculate the proportion of daylight hours at current latitude and effective tilt
+	double daylight_proportion = (pi + 2.0 * extra_logitude) / (2 * pi);
+
+	// calculate solar radiation strength at current effective latitude
+	double radiation_strength = max(0., cos((effective_latitude / 360) * 2 * pi));
+
+	// calculate base and moderated temperatures relative to equatorial temperature
+	double base_factor = radiation_strength * (daylight_proportion * 2);
+	double moderated_factor = ((base_factor - temperature_moderation_bias) / temperature_moderation_factor)
+		+ temperature_moderation_bias;
+
+	// account for greenhouse effect
+	return moderated_factor * greenhouse_factor;
+}
+
+// get terms of the temperature formula which depend only on latitude at a y coordinate
+GeneticSimulation::LatitudeTerms GeneticSimulation::TemperatureModel::get_latitude_terms(unsigned int y) const
+{
+	double latitude_radians = (get_latitude(y) / 360.0) * 2 * pi;
+	double height_to_latitude = sin(latitude_radians) * radius;
+	double width_at_latitude = max(0., cos(latitude_radians) * radius);
+	// the ratio of the tilted plane distance to the width at latitude is the tangent of the tilt times
+	// this, which is infinite with the sign of the height where the width is 0
+	double tan_latitude = width_at_latitude == 0 ?
+		boost::math::sign(height_to_latitude) * std::numeric_limits<float>::max() :
+		height_to_latitude / width_at_latitude;
+	return { static_cast<float>(tan_latitude), static_cast<float>(cos(latitude_radians)),
+		static_cast<float>(sin(latitude_radians)) };
+}
+
+// get terms of the temperature formula which depend only on timestep for a range of timesteps
+GeneticSimulation::TimestepTerms GeneticSimulation::TemperatureModel::get_timestep_terms(unsigned int start_t,
+	unsigned int end_t) const
+{
+	TimestepTerms terms;
+	auto range = end_t > start_t ? end_t - start_t : 0;
+	terms.equatorial_temperatures.resize(range);
+	terms.tan_tilts.resize(range);
+	terms.cos_tilts.resize(range);
+	terms.sin_tilts.resize(range);
+	for (unsigned int i = 0; i < range; i++) {
+		terms.equatorial_temperatures[i] = static_cast<float>(get_equatorial_temperature(start_t + i));
+		get_tilt_terms(start_t + i, terms.tan_tilts[i], terms.cos_tilts[i], terms.sin_tilts[i]);
+	}
+	return terms;
+}
+
+// get tangent, cosine and sine of effective axial tilt at a timestep
+void GeneticSimulation::TemperatureModel::get_tilt_terms(unsigned int t, float& tan_tilt, float& cos_tilt, float& sin_tilt) const
+{
+	double tilt_radians = (get_effective_axial_tilt(t) / 360.0) * 2 * pi;
+	tan_tilt = static_cast<float>(tan(tilt_radians));
+	cos_tilt = static_cast<float>(cos(tilt_radians));
+	sin_tilt = static_cast<float>(sin(tilt_radians));
+}
+
+// get slope and intercept of surface factor as a linear function of 
+// radiation strength multiplied by proportion of daylight hours
+float GeneticSimulation::TemperatureModel::get_moderation_slope() const
+{
+	return static_cast<float>(2 * greenhouse_factor / temperature_moderation_factor);
+}
+
+float GeneticSimulation::TemperatureModel::get_moderation_intercept() const
+{
+	return static_cast<float>(greenhouse_factor * temperature_moderation_bias * (1 - 1 / temperature_moderation_factor));
+}
+
+// get temperature at a y coordinate and timestep
+double GeneticSimulation::TemperatureModel::get_temperature(unsigned int y, unsigned int t) const
+{
+	return get_equatorial_temperature(t) * get_surface_factor(get_latitude(y), get_effective_axial_tilt(t));
+}
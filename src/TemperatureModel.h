@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Config.h"
+#include "TemperatureKernel.h"
+
+namespace GeneticSimulation
+{
+	// Planetary surface temperature model, separated into a term which depends only
+	// on the timestep (equatorial temperature) and a term which depends only on the
+	// latitude and the effective axial tilt at the timestep (surface factor), so that
+	// temperature(y, t) = equatorial temperature(t) * surface factor(latitude(y), tilt(t))
+	class TemperatureModel
+	{
+	public:
+
+		// constructor which takes planet and area options from config
+		explicit TemperatureModel(const Config& config);
+
+		// get equatorial black body temperature at a timestep
+		double get_equatorial_temperature(unsigned int t) const;
+
+		// get effective axial tilt in degrees at a timestep
+		double get_effective_axial_tilt(unsigned int t) const;
+
+		// get latitude in degrees of a y coordinate
+		double get_latitude(unsigned int y) const;
+
+		// get ratio of surface temperature to equatorial temperature at a latitude and effective axial tilt,
+		// accounting for daylight hours, radiation strength, moderation and greenhouse effect
+		double get_surface_factor(double latitude, double effective_axial_tilt) const;
+
+		// get temperature at a y coordinate and timestep
+		double get_temperature(unsigned int y, unsigned int t) const;
+
+		// get terms of the temperature formula which depend only on latitude at a y coordinate
+		LatitudeTerms get_latitude_terms(unsigned int y) const;
+
+		// get terms of the temperature formula which depend only on timestep for a range of timesteps
+		TimestepTerms get_timestep_terms(unsigned int start_t, unsigned int end_t) const;
+
+		// get tangent, cosine and sine of effective axial tilt at a timestep
+		void get_tilt_terms(unsigned int t, float& tan_tilt, float& cos_tilt, float& sin_tilt) const;
+
+		// get slope and intercept of surface factor as a linear function of 
+		// radiation strength multiplied by proportion of daylight hours
+		float get_moderation_slope() const;
+		float get_moderation_intercept() const;
+
+	private:
+
+		// planet and area options
+		unsigned int area_height;
+		unsigned int orbital_period;
+		double orbit_center_offset_x;
+		double orbit_center_offset_y;
+		double orbit_radius_x;
+		double orbit_radius_y;
+		double orbit_rotation;
+		double star_luminosity;
+		double albedo;
+		double axial_tilt;
+		double radius;
+		double temperature_moderation_factor;
+		double temperature_moderation_bias;
+		// factor by which greenhouse effect raises temperatures
+		double greenhouse_factor;
+	};
+}
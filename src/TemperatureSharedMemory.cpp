@@ -0,0 +1,217 @@
+#include "TemperatureSharedMemory.h"
+#include "TemperatureCache.h"
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#ifdef SHARED_MEMORY_SUPPORT
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#endif
+
+using std::string;
+using std::size_t;
+using std::cout;
+using std::cerr;
+
+// magic bytes and format version identifying shared tables (version changes whenever layout changes)
+static const char shared_magic[8] = { 'G', 'S', 'S', 'H', 'M', 'T', 'M', 'P' };
+static const uint32_t shared_version = 1;
+
+// constructor which takes the config and storage of the table
+GeneticSimulation::TemperatureSharedMemory::TemperatureSharedMemory(const Config& config, temperature_storage storage) :
+	parameter_hash(TemperatureCache::hash_parameters(config, storage)), storage(storage),
+	area_height(config.area_height), orbital_period(config.orbital_period), descriptor(-1), lock_descriptor(-1),
+	mapping(nullptr), mapping_bytes(0)
+{
+	// name segment by hash (which covers storage), keeping within the shortest name length limits
+	std::ostringstream segment_name;
+	segment_name << "/gstemps_" << std::hex << std::setw(16) << std::setfill('0') << parameter_hash;
+	name = segment_name.str();
+	lock_name = name + "_lock";
+
+#ifdef SHARED_MEMORY_SUPPORT
+	// open segment and its publish lock, creating them empty if no other process has, and hold the
+	// segment lock shared for as long as this process is attached
+	descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+	if (descriptor != -1) {
+		lock_descriptor = shm_open(lock_name.c_str(), O_RDWR | O_CREAT, 0600);
+	}
+	if (descriptor == -1 || lock_descriptor == -1 || flock(descriptor, LOCK_SH) != 0) {
+		cerr << "Opening shared memory " << name << " failed: " << std::strerror(errno) << "\n";
+		close_descriptors();
+	}
+#else
+	cerr << "Shared memory temperatures are not supported on this platform\n";
+#endif
+}
+
+// destructor which detaches from the segment, removing it if no other process is attached
+GeneticSimulation::TemperatureSharedMemory::~TemperatureSharedMemory()
+{
+	unmap();
+#ifdef SHARED_MEMORY_SUPPORT
+	if (descriptor == -1) return;
+	// every attached process holds the segment lock shared, so it can only be taken exclusively by the
+	// last one (a process that opened the segment just before it is removed still attaches to its table,
+	// but the next process creates a new segment)
+	if (flock(descriptor, LOCK_EX | LOCK_NB) == 0) {
+		shm_unlink(name.c_str());
+		shm_unlink(lock_name.c_str());
+	}
+	close_descriptors();
+#endif
+}
+
+// attach to table if another process has published it, returning pointer to table (null if not
+// published yet) and setting the quantization offset and scale stored with it
+const char* GeneticSimulation::TemperatureSharedMemory::attach(size_t bytes, double& quantization_offset,
+	double& quantization_scale)
+{
+#ifdef SHARED_MEMORY_SUPPORT
+	if (descriptor == -1) return nullptr;
+
+	// take publish lock, waiting until any process publishing the table has finished (the publish lock
+	// is separate from the segment lock held shared by attached processes, so processes starting at
+	// the same time never wait on each other's attachment)
+	if (flock(lock_descriptor, LOCK_EX) != 0) {
+		cerr << "Locking shared memory " << name << " failed: " << std::strerror(errno) << "\n";
+		close_descriptors();
+		return nullptr;
+	}
+
+	// map table if it is complete and let the next process check, otherwise keep the lock to publish it
+	if (auto table = map_published(bytes, quantization_offset, quantization_scale)) {
+		flock(lock_descriptor, LOCK_UN);
+		cout << "Attached to temperatures in shared memory " << name << "\n";
+		return table;
+	}
+#endif
+	return nullptr;
+}
+
+// publish table for other processes and release the publish lock, returning pointer to the shared copy of the table
+const char* GeneticSimulation::TemperatureSharedMemory::publish(const char* data, size_t bytes,
+	double quantization_offset, double quantization_scale)
+{
+#ifdef SHARED_MEMORY_SUPPORT
+	if (descriptor == -1) return nullptr;
+	unmap();
+
+	// resize segment, truncating first so that a table left incomplete by a process which failed
+	// while publishing is cleared
+	size_t segment_bytes = table_offset + bytes;
+	void* writable = MAP_FAILED;
+	if (ftruncate(descriptor, 0) == 0 && ftruncate(descriptor, static_cast<off_t>(segment_bytes)) == 0) {
+		writable = mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	}
+	if (writable == MAP_FAILED) {
+		cerr << "Publishing temperatures to shared memory " << name << " failed: " << std::strerror(errno) << "\n";
+		// closing the descriptors releases the locks so that waiting processes compute their own tables
+		close_descriptors();
+		return nullptr;
+	}
+
+	// write header and table, then mark table as ready
+	auto header = make_header(bytes);
+	header.quantization_offset = quantization_offset;
+	header.quantization_scale = quantization_scale;
+	std::memcpy(writable, &header, sizeof(Header));
+	std::memcpy(static_cast<char*>(writable) + table_offset, data, bytes);
+	static_cast<Header*>(writable)->ready = 1;
+	munmap(writable, segment_bytes);
+
+	// map table read-only and let waiting processes attach
+	mapping = mmap(nullptr, segment_bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+	flock(lock_descriptor, LOCK_UN);
+	if (mapping == MAP_FAILED) {
+		mapping = nullptr;
+		return nullptr;
+	}
+	mapping_bytes = segment_bytes;
+	cout << "Published temperatures to shared memory " << name << "\n";
+	return static_cast<const char*>(mapping) + table_offset;
+#else
+	return nullptr;
+#endif
+}
+
+// get number of bytes of table currently mapped
+size_t GeneticSimulation::TemperatureSharedMemory::get_mapped_size() const
+{
+	return mapping ? mapping_bytes - table_offset : 0;
+}
+
+// fill in header fields which identify the table
+GeneticSimulation::TemperatureSharedMemory::Header GeneticSimulation::TemperatureSharedMemory::make_header(size_t bytes) const
+{
+	Header header{};
+	std::memcpy(header.magic, shared_magic, sizeof(header.magic));
+	header.version = shared_version;
+	header.storage = static_cast<uint32_t>(storage);
+	header.parameter_hash = parameter_hash;
+	header.area_height = area_height;
+	header.orbital_period = orbital_period;
+	header.table_bytes = bytes;
+	return header;
+}
+
+// map segment if it holds a complete table matching the config, returning pointer to table
+const char* GeneticSimulation::TemperatureSharedMemory::map_published(size_t bytes, double& quantization_offset,
+	double& quantization_scale)
+{
+#ifdef SHARED_MEMORY_SUPPORT
+	// check segment is the expected size (a new segment is empty)
+	struct stat status;
+	size_t segment_bytes = table_offset + bytes;
+	if (fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) != segment_bytes) return nullptr;
+	void* published = mmap(nullptr, segment_bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+	if (published == MAP_FAILED) return nullptr;
+
+	// check header matches table and table is complete
+	Header header;
+	std::memcpy(&header, published, sizeof(Header));
+	auto expected = make_header(bytes);
+	if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+		header.version != expected.version || header.storage != expected.storage ||
+		header.parameter_hash != expected.parameter_hash || header.area_height != expected.area_height ||
+		header.orbital_period != expected.orbital_period || header.table_bytes != expected.table_bytes ||
+		header.ready != 1) {
+		munmap(published, segment_bytes);
+		return nullptr;
+	}
+
+	mapping = published;
+	mapping_bytes = segment_bytes;
+	quantization_offset = header.quantization_offset;
+	quantization_scale = header.quantization_scale;
+	return static_cast<const char*>(mapping) + table_offset;
+#else
+	return nullptr;
+#endif
+}
+
+// close segment and publish lock, releasing locks held on them
+void GeneticSimulation::TemperatureSharedMemory::close_descriptors()
+{
+#ifdef SHARED_MEMORY_SUPPORT
+	if (descriptor != -1) close(descriptor);
+	if (lock_descriptor != -1) close(lock_descriptor);
+#endif
+	descriptor = -1;
+	lock_descriptor = -1;
+}
+
+// unmap segment
+void GeneticSimulation::TemperatureSharedMemory::unmap()
+{
+#ifdef SHARED_MEMORY_SUPPORT
+	if (mapping) munmap(mapping, mapping_bytes);
+#endif
+	mapping = nullptr;
+	mapping_bytes = 0;
+}
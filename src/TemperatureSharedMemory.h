@@ -0,0 +1,96 @@
+#pragma once
+
+#include "helper/platform.h"
+#include "Config.h"
+#include "TemperatureStorage.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace GeneticSimulation
+{
+	// A named shared memory segment holding a table of precomputed temperatures, named by a hash of
+	// every option that affects them, which the first process to take its publish lock fills and later
+	// processes map read-only, so that concurrent processes precompute and store one table between them
+	// (every attached process holds the segment lock shared, and the segment is removed when the last
+	// one detaches)
+	class TemperatureSharedMemory
+	{
+	public:
+
+		// constructor which takes the config and storage of the table
+		TemperatureSharedMemory(const Config& config, temperature_storage storage);
+
+		// destructor which detaches from the segment, removing it if no other process is attached
+		~TemperatureSharedMemory();
+
+		TemperatureSharedMemory(const TemperatureSharedMemory&) = delete;
+		TemperatureSharedMemory& operator=(const TemperatureSharedMemory&) = delete;
+
+		// attach to table if another process has published it, returning pointer to table (null if not
+		// published yet) and setting the quantization offset and scale stored with it (when null is
+		// returned the caller holds the publish lock until publishing, so other processes wait for the
+		// table rather than computing it too)
+		const char* attach(std::size_t bytes, double& quantization_offset, double& quantization_scale);
+
+		// publish table for other processes and release the publish lock, returning pointer to the shared
+		// copy of the table (null if publishing failed)
+		const char* publish(const char* data, std::size_t bytes, double quantization_offset, double quantization_scale);
+
+		// get number of bytes of table currently mapped
+		std::size_t get_mapped_size() const;
+
+		// get name of segment
+		const std::string& get_name() const { return name; }
+
+	private:
+
+		// header at start of segment, where ready is set only after the table has been written
+		struct Header
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t storage;
+			uint64_t parameter_hash;
+			uint32_t area_height;
+			uint32_t orbital_period;
+			double quantization_offset;
+			double quantization_scale;
+			uint64_t table_bytes;
+			uint64_t ready;
+		};
+
+		// offset of table in segment, keeping it aligned to a cache line
+		static constexpr std::size_t table_offset = (sizeof(Header) + 63) / 64 * 64;
+
+		// fill in header fields which identify the table
+		Header make_header(std::size_t bytes) const;
+
+		// map segment if it holds a complete table matching the config, returning pointer to table
+		const char* map_published(std::size_t bytes, double& quantization_offset, double& quantization_scale);
+
+		// close segment and publish lock, releasing locks held on them
+		void close_descriptors();
+
+		// unmap segment
+		void unmap();
+
+		// name of segment
+		std::string name;
+		// hash of options affecting temperatures
+		uint64_t parameter_hash;
+		// storage and dimensions of table
+		temperature_storage storage;
+		unsigned int area_height;
+		unsigned int orbital_period;
+		// name of segment locked exclusively while checking for and publishing the table
+		std::string lock_name;
+		// descriptor of segment (-1 if not open), whose lock is held shared while attached
+		int descriptor;
+		// descriptor of publish lock segment (-1 if not open)
+		int lock_descriptor;
+		// mapped segment and its size in bytes
+		void* mapping;
+		std::size_t mapping_bytes;
+	};
+}
@@ -0,0 +1,35 @@
+#include "TemperatureStorage.h"
+#include <iostream>
+
+// get name of a temperature storage
+const char* GeneticSimulation::get_temperature_storage_name(temperature_storage s)
+{
+	switch (s) {
+	case full_storage: return "full";
+	case quantized_storage: return "quantized";
+	case factored_storage: return "factored";
+	case sampled_storage: return "sampled";
+	case windowed_storage: return "windowed";
+	default: return "unknown";
+	}
+}
+
+// get temperature storage from its name (full storage if not recognized)
+GeneticSimulation::temperature_storage GeneticSimulation::parse_temperature_storage(const std::string& name)
+{
+	for (unsigned int s = 0; s < num_temperature_storages; s++) {
+		if (name == get_temperature_storage_name(static_cast<temperature_storage>(s))) {
+			return static_cast<temperature_storage>(s);
+		}
+	}
+	std::cerr << "Unknown temperature storage: " << name << ", using full\n";
+	return full_storage;
+}
+
+// get temperature interpolation from its name (cubic if not recognized)
+GeneticSimulation::temperature_interpolation GeneticSimulation::parse_temperature_interpolation(const std::string& name)
+{
+	if (name == "linear") return linear_interpolation;
+	if (name != "cubic") std::cerr << "Unknown temperature interpolation: " << name << ", using cubic\n";
+	return cubic_interpolation;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+namespace GeneticSimulation
+{
+	// ways of storing precomputed planetary surface temperatures
+	enum temperature_storage {
+		// one float per latitude per timestep
+		full_storage,
+		// one 16-bit linearly quantized value per latitude per timestep
+		quantized_storage,
+		// equatorial temperature per timestep and surface factor per latitude per sampled axial tilt
+		factored_storage,
+		// one float per latitude every temperature_stride timesteps, interpolated between them
+		sampled_storage,
+		// one float per latitude for a window of upcoming timesteps, computed in the background
+		windowed_storage,
+		num_temperature_storages
+	};
+
+	// ways of interpolating between sampled timesteps
+	enum temperature_interpolation {
+		linear_interpolation,
+		// Catmull-Rom spline through the two samples either side
+		cubic_interpolation
+	};
+
+	// get name of a temperature storage
+	const char* get_temperature_storage_name(temperature_storage s);
+
+	// get temperature storage from its name (full storage if not recognized)
+	temperature_storage parse_temperature_storage(const std::string& name);
+
+	// get temperature interpolation from its name (cubic if not recognized)
+	temperature_interpolation parse_temperature_interpolation(const std::string& name);
+}
@@ -0,0 +1,220 @@
+#include "ValidationHarness.h"
+#include "Simulation.h"
+#include "helper/statistics.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+
+using std::vector;
+using std::string;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::fixed;
+using std::setprecision;
+using std::setw;
+using std::left;
+using std::right;
+using std::max;
+using std::memory_order_relaxed;
+
+using namespace GeneticSimulation;
+
+// names of validation metrics
+static const char* validation_metric_names[num_validation_metrics] = {
+	"population_size", "mean_fitness", "mean_area_of_influence", "mean_speed",
+	"mean_health_rate", "mean_ideal_temp", "mean_temp_range", "birth_rate", "death_rate"
+};
+
+// get name of a validation metric
+const char* GeneticSimulation::get_validation_metric_name(validation_metric m)
+{
+	return validation_metric_names[m];
+}
+
+// constructor which takes the candidate configuration
+GeneticSimulation::ValidationHarness::ValidationHarness(const Config& config) :
+	config(config), samples(config.validation_timesteps / config.validation_sample_interval) {}
+
+// run all seeds for reference and candidate, report results and return exit status
+// (0 if no test rejects the hypothesis that the distributions are the same)
+int GeneticSimulation::ValidationHarness::run()
+{
+	vector<ValidationRun> reference_runs, candidate_runs;
+	cout << "Validating candidate with " << config.simulation_threads << " simulation threads against "
+		<< "single-threaded reference over " << config.validation_seeds << " seeds of "
+		<< samples * config.validation_sample_interval << " timesteps\n";
+
+	// run reference and candidate for each seed
+	for (unsigned int s = 0; s < config.validation_seeds; s++) {
+		int seed = config.random_seed_factor + static_cast<int>(s);
+		cout << "Seed " << s + 1 << "/" << config.validation_seeds << ": reference" << std::flush;
+		reference_runs.push_back(record_run(make_run_config(seed, true)));
+		cout << ", candidate" << std::flush;
+		candidate_runs.push_back(record_run(make_run_config(seed, false)));
+		cout << "\n";
+	}
+
+	// test each metric at each sample time, correcting significance level for number of tests
+	unsigned int tests = samples * num_validation_metrics;
+	double threshold = config.validation_significance / max(1u, tests);
+	unsigned int failures = 0;
+	cout << "Kolmogorov-Smirnov tests at significance " << config.validation_significance
+		<< " (Bonferroni-corrected to " << threshold << " over " << tests << " tests):\n";
+	cout << "  " << left << setw(24) << "metric" << right << setw(16) << "reference mean"
+		<< setw(16) << "candidate mean" << setw(12) << "min p" << setw(10) << "timestep" << setw(8) << "result\n";
+	for (unsigned int m = 0; m < num_validation_metrics; m++) {
+		auto metric = static_cast<validation_metric>(m);
+		// find the sample time with the smallest p-value
+		double min_p = 1;
+		unsigned int min_p_sample = 0;
+		unsigned int metric_failures = 0;
+		for (unsigned int i = 0; i < samples; i++) {
+			double p = kolmogorov_smirnov_p_value(get_values(reference_runs, i, metric), 
+				get_values(candidate_runs, i, metric));
+			if (p < min_p) {
+				min_p = p;
+				min_p_sample = i;
+			}
+			metric_failures += p < threshold;
+		}
+		failures += metric_failures;
+		// report means at final sample time alongside worst test
+		cout << "  " << left << setw(24) << get_validation_metric_name(metric) << right << fixed << setprecision(3)
+			<< setw(16) << (samples > 0 ? sample_mean(get_values(reference_runs, samples - 1, metric)) : 0)
+			<< setw(16) << (samples > 0 ? sample_mean(get_values(candidate_runs, samples - 1, metric)) : 0)
+			<< std::scientific << setprecision(2) << setw(12) << min_p << std::defaultfloat
+			<< setw(10) << (min_p_sample + 1) * config.validation_sample_interval
+			<< setw(7) << (metric_failures > 0 ? "FAIL" : "pass") << "\n";
+	}
+
+	// write all test results
+	write_results(reference_runs, candidate_runs, threshold, "validation_results_" + 
+		std::to_string(config.simulation_threads) + "_simulation_threads.csv", config.results_path);
+
+	// report overall result
+	if (failures > 0) {
+		cout << "Validation failed: " << failures << " of " << tests 
+			<< " tests found distributions differing from reference\n";
+		return 1;
+	}
+	cout << "Validation passed: no distributions differed from reference\n";
+	return 0;
+}
+
+// create configuration for a run with the given seed, using the reference path if requested
+Config GeneticSimulation::ValidationHarness::make_run_config(int seed, bool reference) const
+{
+	Config run_config = config;
+	run_config.run_mode = 0;
+	run_config.random_seed_factor = seed;
+	run_config.headless = true;
+	run_config.work_report = false;
+	run_config.memory_report = false;
+	run_config.metrics_port = 0;
+	run_config.checkpoint_interval = 0;
+	run_config.checkpoint_restore_path.clear();
+	run_config.telemetry_path.clear();
+	run_config.genome_archive_path.clear();
+	run_config.replay_record_path.clear();
+	run_config.frames_path.clear();
+	run_config.lineage_path.clear();
+	// reference runs use the plain single-threaded path
+	if (reference) {
+		run_config.simulation_threads = 1;
+	}
+	return run_config;
+}
+
+// run simulation headless with a configuration and record metrics at each sample time
+ValidationHarness::ValidationRun GeneticSimulation::ValidationHarness::record_run(const Config& run_config) const
+{
+	ValidationRun run(samples);
+	Simulation simulation(run_config);
+	simulation.init();
+
+	// birth and death totals at previous sample time
+	unsigned long long births = 0, deaths = 0;
+	unsigned int sample = 0;
+	double interval = config.validation_sample_interval;
+	simulation.run_headless(samples * config.validation_sample_interval, 
+		[&](unsigned int t, const Population& population) {
+			if (t % config.validation_sample_interval != 0) return;
+			auto summary = population.summarize();
+			auto& counters = population.get_counters();
+			auto total_births = counters.births.load(memory_order_relaxed);
+			auto total_deaths = counters.deaths.load(memory_order_relaxed);
+			run[sample] = {
+				static_cast<double>(summary.alive), summary.mean_fitness, summary.mean_area_of_influence,
+				summary.mean_speed, summary.mean_health_rate, summary.mean_ideal_temp, summary.mean_temp_range,
+				(total_births - births) / interval, (total_deaths - deaths) / interval
+			};
+			births = total_births;
+			deaths = total_deaths;
+			sample++;
+		});
+	return run;
+}
+
+// write test results for every metric and sample time to file
+void GeneticSimulation::ValidationHarness::write_results(const vector<ValidationRun>& reference_runs,
+	const vector<ValidationRun>& candidate_runs, double threshold, const string& filename, const string& path) const
+{
+	// alias for boost filesystem namespace
+	namespace fs = boost::filesystem;
+
+	// generate path for results file
+	fs::path results_file_path(path);
+	results_file_path /= filename;
+
+	// output name of results file
+	cout << "Writing validation results to " << results_file_path.string() << "\n";
+
+	// attempt to write results
+	try {
+		// open file
+		fs::ofstream results_file(results_file_path, ios::trunc);
+		// print error and return if opening file failed
+		if (!results_file) {
+			cerr << "Writing validation results file failed: Check that the path exists and may be written to\n";
+			return;
+		}
+		// write header
+		results_file << "timestep,metric,reference_mean,reference_sd,candidate_mean,candidate_sd,"
+			"ks_statistic,p_value,pass\n";
+		// write test results
+		for (unsigned int i = 0; i < samples; i++) {
+			for (unsigned int m = 0; m < num_validation_metrics; m++) {
+				auto metric = static_cast<validation_metric>(m);
+				auto reference = get_values(reference_runs, i, metric);
+				auto candidate = get_values(candidate_runs, i, metric);
+				double p = kolmogorov_smirnov_p_value(reference, candidate);
+				results_file << (i + 1) * config.validation_sample_interval << "," 
+					<< get_validation_metric_name(metric) << ","
+					<< sample_mean(reference) << "," << sample_standard_deviation(reference) << ","
+					<< sample_mean(candidate) << "," << sample_standard_deviation(candidate) << ","
+					<< kolmogorov_smirnov_statistic(reference, candidate) << "," << p << ","
+					<< (p < threshold ? 0 : 1) << "\n";
+			}
+		}
+		// close file
+		results_file.close();
+	}
+	catch (const fs::filesystem_error& e) {
+		// if writing results fails, log error
+		cerr << "Writing validation results file failed: " << e.what() << "\n";
+	}
+}
+
+// get values of a metric at a sample time across runs
+vector<double> GeneticSimulation::ValidationHarness::get_values(const vector<ValidationRun>& runs,
+	unsigned int sample, validation_metric m)
+{
+	vector<double> values;
+	values.reserve(runs.size());
+	for (auto& run : runs) {
+		values.push_back(run[sample][m]);
+	}
+	return values;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Config.h"
+#include "Population.h"
+#include <array>
+#include <vector>
+#include <string>
+
+namespace GeneticSimulation
+{
+	// population statistics compared between reference and candidate runs
+	enum validation_metric {
+		population_size_metric, mean_fitness_metric, mean_area_of_influence_metric,
+		mean_speed_metric, mean_health_rate_metric, mean_ideal_temp_metric,
+		mean_temp_range_metric, birth_rate_metric, death_rate_metric, num_validation_metrics
+	};
+
+	// get name of a validation metric
+	const char* get_validation_metric_name(validation_metric m);
+
+	// Runs the reference single-threaded simulation and a candidate configuration headless
+	// for many seeds, and tests whether the distributions of population statistics over
+	// seeds differ at each sample time
+	class ValidationHarness
+	{
+	public:
+
+		// constructor which takes the candidate configuration
+		explicit ValidationHarness(const Config& config);
+
+		// run all seeds for reference and candidate, report results and return exit status
+		// (0 if no test rejects the hypothesis that the distributions are the same)
+		int run();
+
+	private:
+
+		// values of each metric at each sample time of a run
+		using ValidationSample = std::array<double, num_validation_metrics>;
+		using ValidationRun = std::vector<ValidationSample>;
+
+		// create configuration for a run with the given seed, using the reference path if requested
+		Config make_run_config(int seed, bool reference) const;
+
+		// run simulation headless with a configuration and record metrics at each sample time
+		ValidationRun record_run(const Config& run_config) const;
+
+		// write test results for every metric and sample time to file
+		void write_results(const std::vector<ValidationRun>& reference_runs,
+			const std::vector<ValidationRun>& candidate_runs, double threshold,
+			const std::string& filename, const std::string& path) const;
+
+		// get values of a metric at a sample time across runs
+		static std::vector<double> get_values(const std::vector<ValidationRun>& runs,
+			unsigned int sample, validation_metric m);
+
+		// reference to candidate config
+		const Config& config;
+		// number of sample times per run
+		unsigned int samples;
+	};
+}
@@ -0,0 +1,160 @@
+#include "WorkCounters.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+
+using std::vector;
+using std::string;
+using std::cout;
+using std::cerr;
+using std::ios;
+using std::fixed;
+using std::setprecision;
+using std::max;
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+using std::chrono::duration_cast;
+
+using namespace GeneticSimulation;
+
+// constructor which takes the number of simulation threads
+GeneticSimulation::WorkCounters::WorkCounters(unsigned int threads) :
+	threads(max(1u, threads)) {}
+
+// get counters of a simulation thread
+ThreadWorkCounters& GeneticSimulation::WorkCounters::get_thread(unsigned int i)
+{
+	return threads[i];
+}
+
+// calculate load-imbalance factor for a kind of work
+double GeneticSimulation::WorkCounters::get_imbalance(work_type w) const
+{
+	return calculate_imbalance([w](const ThreadWorkCounters& c) { return c.work[w]; });
+}
+
+// calculate load-imbalance factor for time spent waiting at a synchronization point
+double GeneticSimulation::WorkCounters::get_wait_imbalance(wait_point p) const
+{
+	return calculate_imbalance([p](const ThreadWorkCounters& c) { return c.wait_microseconds[p]; });
+}
+
+// calculate load-imbalance factor from a per-thread value
+template<class F>
+double GeneticSimulation::WorkCounters::calculate_imbalance(F value) const
+{
+	// find maximum and total across threads
+	unsigned long long max_value = 0, total = 0;
+	for (auto& c : threads) {
+		max_value = max(max_value, value(c));
+		total += value(c);
+	}
+	// perfectly balanced if no work was done
+	if (total == 0) return 1.0;
+	// max divided by mean
+	return static_cast<double>(max_value) / (static_cast<double>(total) / threads.size());
+}
+
+// print summary and write per-thread counters to file
+void GeneticSimulation::WorkCounters::write_report(const string& filename, const string& path) const
+{
+	// print load-imbalance summary
+	cout << "Load imbalance (max thread work / mean thread work) over " 
+		<< threads[0].timesteps << " timesteps:\n" << fixed << setprecision(3);
+	for (unsigned int w = 0; w < num_work_types; w++) {
+		cout << "  " << get_work_name(static_cast<work_type>(w)) << ": "
+			<< get_imbalance(static_cast<work_type>(w)) << "\n";
+	}
+	for (unsigned int p = 0; p < num_wait_points; p++) {
+		cout << "  " << get_wait_name(static_cast<wait_point>(p)) << "_wait: "
+			<< get_wait_imbalance(static_cast<wait_point>(p)) << "\n";
+	}
+
+	// alias for boost filesystem namespace
+	namespace fs = boost::filesystem;
+
+	// generate path for report file
+	fs::path report_file_path(path);
+	report_file_path /= filename;
+
+	// output name of report file
+	cout << "Writing work counters to " << report_file_path.string() << "\n";
+
+	// attempt to write report
+	try {
+		// open file
+		fs::ofstream report_file(report_file_path, ios::trunc);
+		// print error and return if opening file failed
+		if (!report_file) {
+			cerr << "Writing work counters file failed: Check that the path exists and may be written to\n";
+			return;
+		}
+		// write header
+		report_file << "thread,timesteps";
+		for (unsigned int w = 0; w < num_work_types; w++) {
+			report_file << "," << get_work_name(static_cast<work_type>(w));
+		}
+		for (unsigned int p = 0; p < num_wait_points; p++) {
+			report_file << "," << get_wait_name(static_cast<wait_point>(p)) << "_wait_microseconds";
+		}
+		report_file << "\n";
+		// write a row for each thread
+		for (unsigned int i = 0; i < threads.size(); i++) {
+			report_file << i << "," << threads[i].timesteps;
+			for (auto w : threads[i].work) {
+				report_file << "," << w;
+			}
+			for (auto p : threads[i].wait_microseconds) {
+				report_file << "," << p;
+			}
+			report_file << "\n";
+		}
+		// close file
+		report_file.close();
+	}
+	catch (const fs::filesystem_error& e) {
+		// if writing report fails, log error
+		cerr << "Writing work counters file failed: " << e.what() << "\n";
+	}
+}
+
+// get name of a kind of work
+const char* GeneticSimulation::WorkCounters::get_work_name(work_type w)
+{
+	switch (w) {
+	case interact_pair_tests: return "interact_pair_tests";
+	case resource_range_checks: return "resource_range_checks";
+	case resource_items_scanned: return "resource_items_scanned";
+	case live_organisms_processed: return "live_organisms_processed";
+	default: return "unknown";
+	}
+}
+
+// get name of a synchronization point
+const char* GeneticSimulation::WorkCounters::get_wait_name(wait_point p)
+{
+	switch (p) {
+	case draw_done_wait: return "draw_done";
+	case replication_begin_wait: return "replication_begin";
+	case replication_end_wait: return "replication_end";
+	case end_of_timestep_wait: return "end_of_timestep";
+	default: return "unknown";
+	}
+}
+
+// constructor which takes counters to record into (may be null)
+GeneticSimulation::WaitTimer::WaitTimer(ThreadWorkCounters* counters) : counters(counters) {}
+
+// start timing a wait
+void GeneticSimulation::WaitTimer::start()
+{
+	if (counters) wait_start = steady_clock::now();
+}
+
+// record time since start as waiting at the given synchronization point
+void GeneticSimulation::WaitTimer::stop(wait_point p)
+{
+	if (!counters) return;
+	counters->wait_microseconds[p] += duration_cast<microseconds>(steady_clock::now() - wait_start).count();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+
+namespace GeneticSimulation
+{
+	// kinds of algorithmic work counted by simulation threads
+	enum work_type {
+		interact_pair_tests, resource_range_checks, resource_items_scanned,
+		live_organisms_processed, num_work_types
+	};
+
+	// synchronization points at which simulation threads wait
+	enum wait_point {
+		draw_done_wait, replication_begin_wait, replication_end_wait,
+		end_of_timestep_wait, num_wait_points
+	};
+
+	// Work done and time spent waiting by a single simulation thread, padded
+	// to a cache line so that threads never share a line when counting
+	struct alignas(64) ThreadWorkCounters
+	{
+		// amount of each kind of work done
+		std::array<unsigned long long, num_work_types> work{};
+		// microseconds spent waiting at each synchronization point
+		std::array<unsigned long long, num_wait_points> wait_microseconds{};
+		// number of timesteps completed
+		unsigned long long timesteps = 0;
+	};
+
+	// Per-thread counters of real work done by simulation threads, summarised
+	// per run as a load-imbalance factor (max thread work / mean thread work)
+	class WorkCounters
+	{
+	public:
+
+		// constructor which takes the number of simulation threads
+		explicit WorkCounters(unsigned int threads);
+
+		// get counters of a simulation thread
+		ThreadWorkCounters& get_thread(unsigned int i);
+
+		// calculate load-imbalance factor for a kind of work
+		double get_imbalance(work_type w) const;
+
+		// calculate load-imbalance factor for time spent waiting at a synchronization point
+		double get_wait_imbalance(wait_point p) const;
+
+		// print summary and write per-thread counters to file
+		void write_report(const std::string& filename, const std::string& path) const;
+
+		// get name of a kind of work
+		static const char* get_work_name(work_type w);
+
+		// get name of a synchronization point
+		static const char* get_wait_name(wait_point p);
+
+	private:
+
+		// calculate load-imbalance factor from a per-thread value
+		template<class F>
+		double calculate_imbalance(F value) const;
+
+		// counters for each thread
+		std::vector<ThreadWorkCounters> threads;
+	};
+
+	// Times waits at synchronization points and records them in a thread's
+	// work counters, doing nothing if no counters are given
+	class WaitTimer
+	{
+	public:
+
+		// constructor which takes counters to record into (may be null)
+		explicit WaitTimer(ThreadWorkCounters* counters);
+
+		// start timing a wait
+		void start();
+
+		// record time since start as waiting at the given synchronization point
+		void stop(wait_point p);
+
+	private:
+
+		// counters to record into
+		ThreadWorkCounters* counters;
+		// start of current wait
+		std::chrono::steady_clock::time_point wait_start;
+	};
+}
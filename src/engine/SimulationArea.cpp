@@ -1,5 +1,6 @@
 #include "SimulationArea.h"
 #include "../helper/color.h"
+#include "../helper/numbers.h"
 #include <cmath>
 #include <algorithm>
 #include <limits>
@@ -18,9 +19,10 @@ using std::setprecision;
 
 using namespace GeneticSimulation;
 
-// constructor
+// constructor (the window is not created if headless)
 GeneticSimulation::SimulationArea::SimulationArea(sf::Vector2u area_sz, sf::Vector2u window_sz, 
-	const string& window_title, unsigned int frame_rate, sf::RenderWindow& window, sf::Font& font) :
+	const string& window_title, unsigned int frame_rate, sf::RenderWindow& window, sf::Font& font,
+	bool headless) :
 	viewport_origin(0, 0), zoom_factor(1.f), limit_frame_rate(true),
 	standard_frame_rate(frame_rate), window(window), font(font)
 {
@@ -29,8 +31,10 @@ GeneticSimulation::SimulationArea::SimulationArea(sf::Vector2u area_sz, sf::Vect
 	area_size.y = max(300u, area_sz.y);
 	viewport_size.x = min(area_size.x, max(300u, window_sz.x));
 	viewport_size.y = min(area_size.y, max(300u, window_sz.y));
-	// (re)create window
-	window.create(sf::VideoMode(viewport_size.x, viewport_size.y), window_title);
+	// (re)create window unless headless
+	if (!headless) {
+		window.create(sf::VideoMode(viewport_size.x, viewport_size.y), window_title);
+	}
 	// set up viewport info text element
 	viewport_info.setFont(font);
 	viewport_info.setCharacterSize(14);
@@ -61,6 +65,14 @@ GeneticSimulation::SimulationArea::SimulationArea(sf::Vector2u area_sz, sf::Vect
 	lower_temperature_color.setPosition(viewport_size.x - 40, viewport_size.y -30);
 	lower_temperature_color.setOutlineThickness(2);
 	lower_temperature_color.setOutlineColor(sf::Color::Black);
+	// set up points of circles with each number of points
+	unit_circles.resize(max_circle_points + 1);
+	for (unsigned int points = min_circle_points; points <= max_circle_points; points++) {
+		for (unsigned int i = 0; i < points; i++) {
+			float angle = i * 2.f * pi / points - pi / 2.f;
+			unit_circles[points].emplace_back(cos(angle), sin(angle));
+		}
+	}
 }
 
 // set the location of the viewport
@@ -123,26 +135,64 @@ void GeneticSimulation::SimulationArea::toggle_limit_frame_rate()
 	set_limit_frame_rate(!limit_frame_rate);
 }
 
-// draw a circle shape if it lies partially or wholly within the viewport
-void GeneticSimulation::SimulationArea::draw(sf::CircleShape& shape, sf::Vector2f position, float size)
+// add triangles of a circle with an outline to a batch if it lies partially or wholly within the viewport
+void GeneticSimulation::SimulationArea::add_circle(std::vector<sf::Vertex>& batch, sf::Vector2f position, float size,
+	sf::Color fill_color, sf::Color outline_color, float outline_thickness) const
 {
-	// get window resoultion
+	// get window resolution
 	auto window_res = window.getSize();
 
-	// calculate pixel position of shape relative to viewport
-	sf::Vector2f relative_position((position.x - viewport_origin.x) * zoom_factor, 
-								   (position.y - viewport_origin.y) * zoom_factor);
-
-	// if shape is partially or wholly within viewport
-	if (relative_position.x + size >= 0 && relative_position.x - size < window_res.x
-		&& relative_position.y + size >= 0 && relative_position.y - size < window_res.y)
-	{
-		// set position to relative position
-		shape.setPosition(relative_position);
-		// set scale to zoom factor
-		shape.setScale(zoom_factor, zoom_factor);
-		// draw shape on window
-		window.draw(shape);
+	// calculate pixel position and radius of circle relative to viewport
+	sf::Vector2f center((position.x - viewport_origin.x) * zoom_factor, 
+						(position.y - viewport_origin.y) * zoom_factor);
+	float radius = size * zoom_factor;
+	float outline_radius = (size + outline_thickness) * zoom_factor;
+	float extent = max(radius, outline_radius);
+
+	// return if circle is wholly outside viewport
+	if (center.x + extent < 0 || center.x - extent >= window_res.x
+		|| center.y + extent < 0 || center.y - extent >= window_res.y) {
+		return;
+	}
+
+	// use as few points as keep the edge within a quarter of a pixel of a true circle
+	unsigned int points = max_circle_points;
+	if (extent < 64.f) {
+		float step = acos(1.f - 0.25f / max(extent, 0.25f));
+		points = min(max_circle_points, max(min_circle_points, static_cast<unsigned int>(ceil(pi / step))));
+	}
+	auto& unit = unit_circles[points];
+
+	// fill with a triangle from the center to each edge, as SFML fills a circle shape
+	for (unsigned int i = 0; i < points; i++) {
+		auto& u0 = unit[i];
+		auto& u1 = unit[i + 1 < points ? i + 1 : 0];
+		batch.emplace_back(center, fill_color);
+		batch.emplace_back(center + u0 * radius, fill_color);
+		batch.emplace_back(center + u1 * radius, fill_color);
+	}
+
+	// draw outline over the fill as a ring of two triangles per point
+	if (outline_thickness == 0.f || outline_color.a == 0) return;
+	for (unsigned int i = 0; i < points; i++) {
+		auto& u0 = unit[i];
+		auto& u1 = unit[i + 1 < points ? i + 1 : 0];
+		sf::Vertex a0(center + u0 * radius, outline_color), a1(center + u1 * radius, outline_color);
+		sf::Vertex b0(center + u0 * outline_radius, outline_color), b1(center + u1 * outline_radius, outline_color);
+		batch.push_back(a0);
+		batch.push_back(b0);
+		batch.push_back(a1);
+		batch.push_back(a1);
+		batch.push_back(b0);
+		batch.push_back(b1);
+	}
+}
+
+// draw a batch of triangles in a single draw call
+void GeneticSimulation::SimulationArea::draw(const std::vector<sf::Vertex>& batch)
+{
+	if (!batch.empty()) {
+		window.draw(batch.data(), batch.size(), sf::Triangles);
 	}
 }
 
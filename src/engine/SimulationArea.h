@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 
@@ -11,10 +12,10 @@ namespace GeneticSimulation
 	{
 	public:
 
-		// constructor
+		// constructor (the window is not created if headless)
 		SimulationArea(sf::Vector2u area_sz, sf::Vector2u window_sz, 
 			const std::string& window_title, unsigned int frame_rate, 
-			sf::RenderWindow& window, sf::Font& font);
+			sf::RenderWindow& window, sf::Font& font, bool headless = false);
 
 		// set the location of the viewport
 		void set_viewport_location(int x, int y);
@@ -34,8 +35,13 @@ namespace GeneticSimulation
 		// toggle frame rate limit
 		void toggle_limit_frame_rate();
 
-		// draw a circle shape if it lies partially or wholly within the viewport
-		void draw(sf::CircleShape& shape, sf::Vector2f position, float size);
+		// add triangles of a circle with an outline drawn inwards (negative thickness) or outwards
+		// to a batch in window coordinates, if it lies partially or wholly within the viewport
+		void add_circle(std::vector<sf::Vertex>& batch, sf::Vector2f position, float size,
+			sf::Color fill_color, sf::Color outline_color, float outline_thickness) const;
+
+		// draw a batch of triangles in a single draw call
+		void draw(const std::vector<sf::Vertex>& batch);
 
 		// draw information on the viewport (location, zoom, time, temperature)
 		void draw_annotations(unsigned int time, float upper_temp, float lower_temp);
@@ -52,8 +58,16 @@ namespace GeneticSimulation
 		// get whether frame rate is limited
 		bool get_limit_frame_rate() const;
 
+		// most points around the edge of a circle, and vertices of a circle with that many points
+		// (a triangle per point for the fill and two per point for the outline)
+		static constexpr unsigned int max_circle_points = 30;
+		static constexpr unsigned int max_circle_vertices = 9 * max_circle_points;
+
 	private:
 
+		// fewest points around the edge of a circle
+		static constexpr unsigned int min_circle_points = 8;
+
 		// size of the area in cells
 		sf::Vector2u area_size;
 		// origin cell coordinates of the viewport
@@ -78,6 +92,8 @@ namespace GeneticSimulation
 		sf::Text lower_temperature;
 		// coloured rectangle representing lower temperature
 		sf::RectangleShape lower_temperature_color;
+		// points on the unit circle for each number of points, starting at the top as in SFML
+		std::vector<std::vector<sf::Vector2f>> unit_circles;
 		// render window
 		sf::RenderWindow& window;
 		// font
@@ -9,7 +9,7 @@ using namespace GeneticSimulation;
 
 // constructor which takes the simulation area in which the object exists
 GeneticSimulation::SimulationObject::SimulationObject(SimulationArea& area) :
-	exists(false), size(0.f), wrap(false), position{ 0.f, 0.f },
+	exists(false), size(0.f), wrap(false), outline_thickness(0.f), position{ 0.f, 0.f },
 	velocity{ 0.f, 0.f }, area(area) {}
 
 // pure virtual destructor definition
@@ -63,47 +63,51 @@ void GeneticSimulation::SimulationObject::update_position_wrap()
 	}
 }
 
-// draw sprite on screen
-void GeneticSimulation::SimulationObject::draw()
+// add sprite to a batch of vertices drawn together
+void GeneticSimulation::SimulationObject::draw(std::vector<sf::Vertex>& batch) const
 {
 	// return if not alive
 	if (!exists) return;
 	
-	// if organism may be in process or wrapping around
-	if (wrap) {
-		// calculate bounds
-		auto area_size = area.get_size();
-		sf::Vector2f bounds_max(area_size.x - size - 1.f, area_size.y - size - 1.f);
-		sf::Vector2f bounds_min(size, size);
-		// whether to draw in two positions
-		bool currently_wrapping = false;
-		// second position as sprite wraps around
-		sf::Vector2f second_position = position;
-		// calculate second position if necessary
-		if (position.x > bounds_max.x) {
-			currently_wrapping = true;
-			second_position.x = -(area_size.x - 1.f - position.x);
-		}
-		else if (position.x < bounds_min.x) {
-			currently_wrapping = true;
-			second_position.x = area_size.x - 1.f + position.x;
-		}
-		if (position.y > bounds_max.y) {
-			currently_wrapping = true;
-			second_position.y = -(area_size.y - 1.f - position.y);
-		}
-		else if (position.y < bounds_min.y) {
-			currently_wrapping = true;
-			second_position.y = area_size.y - 1.f + position.y;
-		}
-		// draw sprite in second position if necessary
-		if (currently_wrapping) {
-			area.draw(sprite, second_position, size);
-		}
+	// if organism may be in process of wrapping around, draw sprite at the opposite edges too
+	sf::Vector2f second_position;
+	if (wrap && get_wrapped_position(position, size, area.get_size(), second_position)) {
+		area.add_circle(batch, second_position, size, fill_color, outline_color, outline_thickness);
 	}
 
 	// draw sprite
-	area.draw(sprite, position, size);
+	area.add_circle(batch, position, size, fill_color, outline_color, outline_thickness);
+}
+
+// get position at which a sprite is drawn a second time while wrapping around the edges of an area,
+// returning false if it does not currently overlap an edge
+bool GeneticSimulation::SimulationObject::get_wrapped_position(sf::Vector2f position, float size,
+	sf::Vector2u area_size, sf::Vector2f& second_position)
+{
+	// calculate bounds
+	sf::Vector2f bounds_max(area_size.x - size - 1.f, area_size.y - size - 1.f);
+	sf::Vector2f bounds_min(size, size);
+	// whether to draw in two positions
+	bool currently_wrapping = false;
+	// calculate second position as sprite wraps around
+	second_position = position;
+	if (position.x > bounds_max.x) {
+		currently_wrapping = true;
+		second_position.x = -(area_size.x - 1.f - position.x);
+	}
+	else if (position.x < bounds_min.x) {
+		currently_wrapping = true;
+		second_position.x = area_size.x - 1.f + position.x;
+	}
+	if (position.y > bounds_max.y) {
+		currently_wrapping = true;
+		second_position.y = -(area_size.y - 1.f - position.y);
+	}
+	else if (position.y < bounds_min.y) {
+		currently_wrapping = true;
+		second_position.y = area_size.y - 1.f + position.y;
+	}
+	return currently_wrapping;
 }
 
 // get whether object is allocated / alive
@@ -124,6 +128,36 @@ sf::Vector2f GeneticSimulation::SimulationObject::get_position() const
 	return position;
 }
 
+// write existence, size, position and velocity to a checkpoint
+void GeneticSimulation::SimulationObject::write_checkpoint(CheckpointWriter& writer) const
+{
+	writer.write(exists);
+	writer.write(size);
+	writer.write(wrap);
+	writer.write(position);
+	writer.write(velocity);
+}
+
+// read existence, size, position and velocity from a checkpoint
+void GeneticSimulation::SimulationObject::read_checkpoint(CheckpointReader& reader)
+{
+	reader.read(exists);
+	set_size(reader.read<float>());
+	reader.read(wrap);
+	reader.read(position);
+	reader.read(velocity);
+}
+
+// set existence, position and size from a replay frame, and whether it may be wrapping
+void GeneticSimulation::SimulationObject::set_replay_state(bool status, sf::Vector2f new_pos, float new_size,
+	bool wrapping)
+{
+	exists = status;
+	position = new_pos;
+	wrap = wrapping;
+	if (new_size != size) set_size(new_size);
+}
+
 // get area size
 sf::Vector2u GeneticSimulation::SimulationObject::get_area_size() const
 {
@@ -158,25 +192,23 @@ void GeneticSimulation::SimulationObject::set_velocity(float heading, float spee
 // set sprite color
 void GeneticSimulation::SimulationObject::set_sprite_color(sf::Color color)
 {
-	sprite.setFillColor(color);
+	fill_color = color;
 }
 
 // set sprite outline color
 void GeneticSimulation::SimulationObject::set_sprite_outline_color(sf::Color color)
 {
-	sprite.setOutlineColor(color);
+	outline_color = color;
 }
 
 // set sprite outline thickness
 void GeneticSimulation::SimulationObject::set_sprite_outline_thickness(float thickness)
 {
-	sprite.setOutlineThickness(thickness);
+	outline_thickness = thickness;
 }
 
 // set sprite size
 void GeneticSimulation::SimulationObject::set_size(float new_size)
 {
 	size = new_size;
-	sprite.setRadius(size);
-	sprite.setOrigin(size, size);
 }
\ No newline at end of file
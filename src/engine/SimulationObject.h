@@ -1,6 +1,9 @@
 #pragma once
 
 #include "SimulationArea.h"
+#include "../helper/Checkpoint.h"
+#include <cstddef>
+#include <vector>
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 
@@ -24,8 +27,14 @@ namespace GeneticSimulation
 		// update position based on velocity and wrap if out of bounds
 		void update_position_wrap();
 
-		// draw sprite on screen
-		void draw();
+		// add sprite to a batch of vertices drawn together, and also at the opposite edges if it is
+		// wrapping around
+		void draw(std::vector<sf::Vertex>& batch) const;
+
+		// get position at which a sprite is drawn a second time while wrapping around the edges of an
+		// area, returning false if it does not currently overlap an edge
+		static bool get_wrapped_position(sf::Vector2f position, float size, sf::Vector2u area_size,
+			sf::Vector2f& second_position);
 
 		// get whether object is allocated / alive
 		bool get_exists() const;
@@ -36,6 +45,15 @@ namespace GeneticSimulation
 		// get object position
 		sf::Vector2f get_position() const;
 
+		// write existence, size, position and velocity to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read existence, size, position and velocity from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
+		// set existence, position and size from a replay frame, and whether it may be wrapping
+		void set_replay_state(bool status, sf::Vector2f new_pos, float new_size, bool wrapping);
+
 	protected:
 
 		// get area size
@@ -73,8 +91,10 @@ namespace GeneticSimulation
 		float size;
 		// whether last movement was potentially wrapping
 		bool wrap;
-		// circular sprite
-		sf::CircleShape sprite;
+		// fill and outline colors and outline thickness of circular sprite
+		sf::Color fill_color;
+		sf::Color outline_color;
+		float outline_thickness;
 		// position of the object
 		sf::Vector2f position;
 		// velocity of the object
@@ -1,9 +1,17 @@
 #pragma once
 
 #include "SimulationObject.h"
+#include "SpatialGrid.h"
 #include "../helper/ConcurrentQueue.h"
+#include "../helper/MemoryFootprint.h"
+#include "../helper/Checkpoint.h"
 #include <type_traits>
 #include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
 
 namespace GeneticSimulation
 {
@@ -19,7 +27,11 @@ namespace GeneticSimulation
 
 		// constructor
 		explicit SimulationObjectPool(unsigned int max_size) :
-			initialized(false), max_size(max_size) {}
+			initialized(false), max_size(max_size) {
+			// reserve space so that adding items and freeing slots never reallocates
+			pool.reserve(max_size);
+			available_slots.reserve(max_size);
+		}
 
 		// element access operators and functions
 		T& operator[](unsigned int i) { return pool[i]; }
@@ -31,11 +43,96 @@ namespace GeneticSimulation
 		unsigned int get_max_size() const { return max_size; }
 		bool get_initialized() const { return initialized; }
 
-		// draw pool items
-		void draw() {
+		// draw pool items in the area in a single draw call, building a batch of their vertices (if
+		// the spatial grid is enabled only items near the viewport are visited, in index order)
+		void draw(SimulationArea& area) {
+			// the batch keeps its capacity, so it only reallocates when more items come into view than before
+			vertices.clear();
+			if (spatial_grid) {
+				auto origin = area.get_viewport_origin();
+				auto size = area.get_viewport_size();
+				visible.clear();
+				spatial_grid->find(sf::FloatRect(static_cast<float>(origin.x), static_cast<float>(origin.y),
+					size.x, size.y), visible);
+				// sort so that overlapping items are drawn in the same order every frame, and remove
+				// items found at both edges
+				std::sort(visible.begin(), visible.end());
+				visible.erase(std::unique(visible.begin(), visible.end()), visible.end());
+				for (auto i : visible) {
+					pool[i].draw(vertices);
+				}
+			}
+			else {
+				for (auto& i : pool) {
+					i.draw(vertices);
+				}
+			}
+			area.draw(vertices);
+		}
+
+		// enable a spatial grid of items over the area, so that drawing visits only items near the viewport
+		// (items must then be updated in the grid whenever they may have moved, appeared or disappeared)
+		void enable_spatial_grid(sf::Vector2u area_size) {
+			if (spatial_grid) return;
+			spatial_grid = std::make_unique<SpatialGrid>(area_size, static_cast<unsigned int>(pool.size()));
+			visible.reserve(pool.size());
+			update_spatial_grid(0, max_size);
+		}
+
+		// update items in the given range in the spatial grid if it is enabled
+		void update_spatial_grid(unsigned int start, unsigned int end) {
+			if (!spatial_grid) return;
+			end = std::min(end, static_cast<unsigned int>(pool.size()));
+			for (unsigned int i = start; i < end; i++) {
+				spatial_grid->update(i, pool[i].get_exists(), pool[i].get_position(), pool[i].get_size());
+			}
+		}
+
+		// add memory used by objects, the batch of their vertices, the spatial grid and the available
+		// slots queue to a footprint
+		void add_memory_usage(MemoryFootprint& footprint, const std::string& name) {
+			footprint.add(name + "_objects", pool.capacity() * sizeof(T));
+			footprint.add(name + "_vertices", vertices.capacity() * sizeof(sf::Vertex));
+			if (spatial_grid) {
+				spatial_grid->add_memory_usage(footprint, name);
+				footprint.add(name + "_spatial_grid", visible.capacity() * sizeof(unsigned int));
+			}
+			footprint.add(name + "_free_slots", available_slots.get_capacity() * sizeof(unsigned int));
+		}
+
+		// write state of each object and the available slots queue to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) {
+			writer.write<uint32_t>(static_cast<uint32_t>(pool.size()));
+			for (auto& i : pool) {
+				i.write_checkpoint(writer);
+			}
+			std::vector<unsigned int> slots;
+			available_slots.get_items(slots);
+			writer.write_vector(slots);
+		}
+
+		// read state of each object and the available slots queue from a checkpoint 
+		// (pool must already hold as many objects as when the checkpoint was written)
+		void read_checkpoint(CheckpointReader& reader) {
+			if (reader.read<uint32_t>() != pool.size()) {
+				throw std::runtime_error("checkpoint pool size does not match config");
+			}
 			for (auto& i : pool) {
-				i.draw();
+				i.read_checkpoint(reader);
+			}
+			// check count before allocating, so that a corrupt count is reported like any other bad checkpoint
+			auto count = reader.read<uint64_t>();
+			if (count > max_size) {
+				throw std::runtime_error("checkpoint has more available slots than pool size");
+			}
+			std::vector<unsigned int> slots(static_cast<std::size_t>(count));
+			for (auto& slot : slots) {
+				reader.read(slot);
+				if (slot >= pool.size()) {
+					throw std::runtime_error("checkpoint available slot is out of range");
+				}
 			}
+			available_slots.assign_items(slots);
 		}
 
 	protected:
@@ -68,6 +165,12 @@ namespace GeneticSimulation
 		const unsigned int max_size;
 		// pool of simulation objects
 		std::vector<T> pool;
+		// vertices of the pool's objects drawn each frame
+		std::vector<sf::Vertex> vertices;
+		// grid of objects for finding those near the viewport (null if disabled), and indices of
+		// objects found for the current frame
+		std::unique_ptr<SpatialGrid> spatial_grid;
+		std::vector<unsigned int> visible;
 		// concurrent queue for keeping track of available/unallocated slots in the pool
 		ConcurrentQueue<unsigned int> available_slots;
 	};
@@ -0,0 +1,117 @@
+#include "SpatialGrid.h"
+#include <cmath>
+#include <algorithm>
+
+using std::min;
+using std::max;
+using std::vector;
+using std::lock_guard;
+using std::mutex;
+using std::memory_order_relaxed;
+
+using namespace GeneticSimulation;
+
+// constructor which takes the area size and the number of objects
+GeneticSimulation::SpatialGrid::SpatialGrid(sf::Vector2u area_size, unsigned int objects) :
+	area_size(area_size), cells_x((area_size.x + cell_size - 1) / cell_size),
+	cells_y((area_size.y + cell_size - 1) / cell_size), cell_heads(static_cast<size_t>(cells_x) * cells_y, none),
+	object_cells(objects, none), next_objects(objects, none), previous_objects(objects, none), max_size(0.f) {}
+
+// record an object in the cell containing its position, or remove it if it does not exist
+void GeneticSimulation::SpatialGrid::update(unsigned int i, bool exists, sf::Vector2f position, float size)
+{
+	// grow largest size (which objects rarely exceed once running)
+	auto largest = max_size.load(memory_order_relaxed);
+	while (size > largest && !max_size.compare_exchange_weak(largest, size, memory_order_relaxed)) {}
+
+	// find cell of position, clamping positions on the edges into the area
+	int32_t cell = none;
+	if (exists) {
+		auto x = min(cells_x - 1, static_cast<unsigned int>(max(0.f, position.x)) / cell_size);
+		auto y = min(cells_y - 1, static_cast<unsigned int>(max(0.f, position.y)) / cell_size);
+		cell = static_cast<int32_t>(y * cells_x + x);
+	}
+
+	// return if object has not changed cell, as is usual for moving objects, without locking (the cell
+	// of an object is only written by the thread updating it)
+	if (cell == object_cells[i]) return;
+
+	// move object from its cell's list to the front of its new cell's list
+	lock_guard<mutex> lock(mx);
+	auto n = static_cast<int32_t>(i);
+	if (object_cells[i] != none) {
+		if (previous_objects[i] != none) next_objects[previous_objects[i]] = next_objects[i];
+		else cell_heads[object_cells[i]] = next_objects[i];
+		if (next_objects[i] != none) previous_objects[next_objects[i]] = previous_objects[i];
+	}
+	object_cells[i] = cell;
+	previous_objects[i] = none;
+	next_objects[i] = none;
+	if (cell != none) {
+		next_objects[i] = cell_heads[cell];
+		if (cell_heads[cell] != none) previous_objects[cell_heads[cell]] = n;
+		cell_heads[cell] = n;
+	}
+}
+
+// add index of every object in the cells overlapping a rectangle widened by the largest object size,
+// and in the cells at the opposite edges of the area if it reaches past an edge
+void GeneticSimulation::SpatialGrid::find(sf::FloatRect rect, vector<unsigned int>& indices) const
+{
+	lock_guard<mutex> lock(mx);
+	// objects drawn at a position also cover their size around it, plus a cell for rounding
+	float margin = max_size.load(memory_order_relaxed) + 1.f;
+	float left = rect.left - margin;
+	float top = rect.top - margin;
+	float right = rect.left + rect.width + margin;
+	float bottom = rect.top + rect.height + margin;
+	// an object wrapping around is drawn a second time offset by the area size less one cell
+	float span_x = area_size.x - 1.f;
+	float span_y = area_size.y - 1.f;
+	for (float dx : { 0.f, span_x, -span_x }) {
+		if ((dx > 0 && left >= 0) || (dx < 0 && right <= span_x)) continue;
+		for (float dy : { 0.f, span_y, -span_y }) {
+			if ((dy > 0 && top >= 0) || (dy < 0 && bottom <= span_y)) continue;
+			find_within_area(left + dx, top + dy, right + dx, bottom + dy, indices);
+		}
+	}
+}
+
+// add memory used by cell lists to a footprint
+void GeneticSimulation::SpatialGrid::add_memory_usage(MemoryFootprint& footprint, const std::string& name) const
+{
+	footprint.add(name + "_spatial_grid", (cell_heads.capacity() + object_cells.capacity() +
+		next_objects.capacity() + previous_objects.capacity()) * sizeof(int32_t));
+}
+
+// estimate memory used by cell lists for an area size and number of objects
+std::size_t GeneticSimulation::SpatialGrid::estimate_memory_usage(sf::Vector2u area_size, unsigned int objects)
+{
+	size_t cells = static_cast<size_t>((area_size.x + cell_size - 1) / cell_size) * ((area_size.y + cell_size - 1) / cell_size);
+	return (cells + 3 * static_cast<size_t>(objects)) * sizeof(int32_t);
+}
+
+// add index of every object in the cells overlapping a rectangle within the area
+void GeneticSimulation::SpatialGrid::find_within_area(float left, float top, float right, float bottom,
+	vector<unsigned int>& indices) const
+{
+	// clip rectangle to area, returning if it lies wholly outside it
+	left = max(0.f, left);
+	top = max(0.f, top);
+	right = min(area_size.x - 1.f, right);
+	bottom = min(area_size.y - 1.f, bottom);
+	if (left > right || top > bottom) return;
+
+	// visit every object in each overlapped cell
+	auto x_start = static_cast<unsigned int>(left) / cell_size;
+	auto x_end = static_cast<unsigned int>(right) / cell_size;
+	auto y_start = static_cast<unsigned int>(top) / cell_size;
+	auto y_end = static_cast<unsigned int>(bottom) / cell_size;
+	for (unsigned int y = y_start; y <= y_end; y++) {
+		for (unsigned int x = x_start; x <= x_end; x++) {
+			for (auto n = cell_heads[y * cells_x + x]; n != none; n = next_objects[n]) {
+				indices.push_back(static_cast<unsigned int>(n));
+			}
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../helper/MemoryFootprint.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <SFML/System.hpp>
+#include <SFML/Graphics.hpp>
+
+namespace GeneticSimulation
+{
+	// A uniform grid over a simulation area recording which cell each object of a pool is in, as a list
+	// of objects per cell linked through arrays indexed by object, so that the objects within a rectangle
+	// can be found by visiting only the cells it overlaps
+	class SpatialGrid
+	{
+	public:
+
+		// side of each cell in area cells
+		static constexpr unsigned int cell_size = 32;
+
+		// constructor which takes the area size and the number of objects
+		SpatialGrid(sf::Vector2u area_size, unsigned int objects);
+
+		// record an object in the cell containing its position, or remove it if it does not exist, and
+		// track the largest size of any object (objects may be updated from different threads as long as
+		// each object is only updated from one thread at a time)
+		void update(unsigned int i, bool exists, sf::Vector2f position, float size);
+
+		// add index of every object in the cells overlapping a rectangle widened by the largest object
+		// size, and in the cells at the opposite edges of the area if it reaches past an edge, so that
+		// objects drawn wrapping around are included (an index may be added more than once)
+		void find(sf::FloatRect rect, std::vector<unsigned int>& indices) const;
+
+		// add memory used by cell lists to a footprint
+		void add_memory_usage(MemoryFootprint& footprint, const std::string& name) const;
+
+		// estimate memory used by cell lists for an area size and number of objects
+		static std::size_t estimate_memory_usage(sf::Vector2u area_size, unsigned int objects);
+
+	private:
+
+		// index marking no object or no cell
+		static constexpr int32_t none = -1;
+
+		// add index of every object in the cells overlapping a rectangle within the area
+		void find_within_area(float left, float top, float right, float bottom, std::vector<unsigned int>& indices) const;
+
+		// size of area and number of cells along each side
+		sf::Vector2u area_size;
+		unsigned int cells_x;
+		unsigned int cells_y;
+		// first object in each cell
+		std::vector<int32_t> cell_heads;
+		// cell of each object, and next and previous object in the same cell
+		std::vector<int32_t> object_cells;
+		std::vector<int32_t> next_objects;
+		std::vector<int32_t> previous_objects;
+		// largest size of any object seen
+		std::atomic<float> max_size;
+		// mutex for moving objects between cells
+		mutable std::mutex mx;
+	};
+}
@@ -1,4 +1,5 @@
 #include "BehaviourNet.h"
+#include <algorithm>
 
 using std::vector;
 using std::default_random_engine;
@@ -51,4 +52,41 @@ void GeneticSimulation::BehaviourNet::transfer_from(const BehaviourNet& donor, f
 	layer1.transfer_from(donor.layer1, donor_weighting);
 	layer2.transfer_from(donor.layer2, donor_weighting);
 	output_layer.transfer_from(donor.output_layer, donor_weighting);
+}
+
+// get heap memory used by layers in bytes
+std::size_t GeneticSimulation::BehaviourNet::get_memory_usage() const
+{
+	return layer1.get_memory_usage() + layer2.get_memory_usage() + output_layer.get_memory_usage();
+}
+
+// get total number of weights in all layers
+std::size_t GeneticSimulation::BehaviourNet::get_num_weights() const
+{
+	return layer1.get_weights().size() + layer2.get_weights().size() + output_layer.get_weights().size();
+}
+
+// copy weights of each layer in turn to an array, returning pointer past the last weight
+float* GeneticSimulation::BehaviourNet::copy_weights(float* out) const
+{
+	for (auto layer : { &layer1, &layer2, &output_layer }) {
+		out = std::copy(layer->get_weights().begin(), layer->get_weights().end(), out);
+	}
+	return out;
+}
+
+// write layer weights to a checkpoint
+void GeneticSimulation::BehaviourNet::write_checkpoint(CheckpointWriter& writer) const
+{
+	layer1.write_checkpoint(writer);
+	layer2.write_checkpoint(writer);
+	output_layer.write_checkpoint(writer);
+}
+
+// read layer weights from a checkpoint
+void GeneticSimulation::BehaviourNet::read_checkpoint(CheckpointReader& reader)
+{
+	layer1.read_checkpoint(reader);
+	layer2.read_checkpoint(reader);
+	output_layer.read_checkpoint(reader);
 }
\ No newline at end of file
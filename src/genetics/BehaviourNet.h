@@ -3,6 +3,7 @@
 #include "BehaviourNetLayer.h"
 #include <vector>
 #include <random>
+#include <cstddef>
 
 namespace GeneticSimulation
 {
@@ -32,6 +33,21 @@ namespace GeneticSimulation
 		// transfer information from donor
 		void transfer_from(const BehaviourNet& donor, float donor_weighting);
 
+		// get heap memory used by layers in bytes
+		std::size_t get_memory_usage() const;
+
+		// get total number of weights in all layers
+		std::size_t get_num_weights() const;
+
+		// copy weights of each layer in turn to an array, returning pointer past the last weight
+		float* copy_weights(float* out) const;
+
+		// write layer weights to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read layer weights from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 	private:
 
 		// layers
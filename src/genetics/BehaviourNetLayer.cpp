@@ -82,6 +82,30 @@ void GeneticSimulation::BehaviourNetLayer::transfer_from(const BehaviourNetLayer
 	combine(weights, donor.weights, weights, donor_weighting);
 }
 
+// get heap memory used by weights and activations in bytes
+std::size_t GeneticSimulation::BehaviourNetLayer::get_memory_usage() const
+{
+	return (weights.capacity() + activations.capacity()) * sizeof(float);
+}
+
+// get weights, stored input-major
+const vector<float>& GeneticSimulation::BehaviourNetLayer::get_weights() const
+{
+	return weights;
+}
+
+// write weights to a checkpoint
+void GeneticSimulation::BehaviourNetLayer::write_checkpoint(CheckpointWriter& writer) const
+{
+	writer.write_vector(weights);
+}
+
+// read weights from a checkpoint
+void GeneticSimulation::BehaviourNetLayer::read_checkpoint(CheckpointReader& reader)
+{
+	reader.read_vector(weights);
+}
+
 // apply sigmoid function to activations
 void GeneticSimulation::BehaviourNetLayer::sigmoid_activation()
 {
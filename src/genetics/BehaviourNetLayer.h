@@ -1,7 +1,9 @@
 #pragma once
 
+#include "../helper/Checkpoint.h"
 #include <vector>
 #include <random>
+#include <cstddef>
 
 namespace GeneticSimulation
 {
@@ -33,6 +35,18 @@ namespace GeneticSimulation
 		// transfer information from another weight vector
 		void transfer_from(const BehaviourNetLayer& donor, float donor_weighting);
 
+		// get heap memory used by weights and activations in bytes
+		std::size_t get_memory_usage() const;
+
+		// get weights, stored input-major
+		const std::vector<float>& get_weights() const;
+
+		// write weights to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read weights from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 	private:
 
 		// apply tanh function to activations
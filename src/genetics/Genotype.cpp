@@ -1,6 +1,7 @@
 #include "Genotype.h"
 #include "genetic_helper.h"
 #include <mutex>
+#include <algorithm>
 
 using std::default_random_engine;
 using std::vector;
@@ -94,6 +95,40 @@ void GeneticSimulation::Genotype::express_traits(Phenotype& phenotype)
 	phenotype.set_temp_range(calculate_trait(12, 3));
 }
 
+// get heap memory used by genes in bytes
+std::size_t GeneticSimulation::Genotype::get_memory_usage() const
+{
+	return behaviour_net.get_memory_usage() + trait_genes.capacity() * sizeof(float);
+}
+
+// get total number of behaviour net weights and trait genes
+std::size_t GeneticSimulation::Genotype::get_num_genes() const
+{
+	return behaviour_net.get_num_weights() + trait_genes.size();
+}
+
+// copy behaviour net weights followed by trait genes to an array (should only be called
+// while genes cannot be transferred), returning pointer past the last gene
+float* GeneticSimulation::Genotype::copy_genes(float* out) const
+{
+	out = behaviour_net.copy_weights(out);
+	return std::copy(trait_genes.begin(), trait_genes.end(), out);
+}
+
+// write genes to a checkpoint
+void GeneticSimulation::Genotype::write_checkpoint(CheckpointWriter& writer) const
+{
+	behaviour_net.write_checkpoint(writer);
+	writer.write_vector(trait_genes);
+}
+
+// read genes from a checkpoint
+void GeneticSimulation::Genotype::read_checkpoint(CheckpointReader& reader)
+{
+	behaviour_net.read_checkpoint(reader);
+	reader.read_vector(trait_genes);
+}
+
 // calculate the value of a trait by combining trait genes
 float GeneticSimulation::Genotype::calculate_trait(unsigned int start_i, unsigned int n, bool negate)
 {
@@ -5,6 +5,7 @@
 #include <random>
 #include <vector>
 #include <mutex>
+#include <cstddef>
 
 namespace GeneticSimulation
 {
@@ -45,6 +46,22 @@ namespace GeneticSimulation
 		// express physical traits based on trait genes and record in phenotype
 		void express_traits(Phenotype& phenotype);
 
+		// get heap memory used by genes in bytes
+		std::size_t get_memory_usage() const;
+
+		// get total number of behaviour net weights and trait genes
+		std::size_t get_num_genes() const;
+
+		// copy behaviour net weights followed by trait genes to an array (should only be called
+		// while genes cannot be transferred), returning pointer past the last gene
+		float* copy_genes(float* out) const;
+
+		// write genes to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read genes from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 	private:
 
 		// calculate the value of a trait by combining trait genes
@@ -68,4 +68,20 @@ void GeneticSimulation::Phenotype::set_ideal_temp(float temp_standardized)
 void GeneticSimulation::Phenotype::set_temp_range(float temp_standardized)
 {
 	temp_range.set_value_from_standardized(temp_standardized);
+}
+
+// write trait values to a checkpoint
+void GeneticSimulation::Phenotype::write_checkpoint(CheckpointWriter& writer) const
+{
+	for (auto trait : { &area_of_influence, &speed, &health_rate, &ideal_temp, &temp_range }) {
+		writer.write(trait->get_value());
+	}
+}
+
+// read trait values from a checkpoint
+void GeneticSimulation::Phenotype::read_checkpoint(CheckpointReader& reader)
+{
+	for (auto trait : { &area_of_influence, &speed, &health_rate, &ideal_temp, &temp_range }) {
+		trait->set_value(reader.read<float>());
+	}
 }
\ No newline at end of file
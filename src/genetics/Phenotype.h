@@ -2,6 +2,7 @@
 
 #include "StandardizeParams.h"
 #include "PhysicalTrait.h"
+#include "../helper/Checkpoint.h"
 
 namespace GeneticSimulation
 {
@@ -29,6 +30,12 @@ namespace GeneticSimulation
 		void set_ideal_temp(float temp_standardized);
 		void set_temp_range(float temp_standardized);
 
+		// write trait values to a checkpoint
+		void write_checkpoint(CheckpointWriter& writer) const;
+
+		// read trait values from a checkpoint
+		void read_checkpoint(CheckpointReader& reader);
+
 	private:
 
 		// traits
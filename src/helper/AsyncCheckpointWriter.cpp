@@ -0,0 +1,126 @@
+#include "AsyncCheckpointWriter.h"
+#include <chrono>
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+using std::string;
+using std::size_t;
+using std::cout;
+using std::cerr;
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+using std::chrono::duration_cast;
+
+// constructor which takes the path checkpoint file names are based on and
+// the number of most recent checkpoints to keep
+GeneticSimulation::AsyncCheckpointWriter::AsyncCheckpointWriter(const string& path, unsigned int keep) :
+	path(path), keep(keep), stop(false)
+{
+	writer_thread = std::thread([this] { run(); });
+}
+
+// destructor which finishes writing any submitted snapshots and stops the thread
+GeneticSimulation::AsyncCheckpointWriter::~AsyncCheckpointWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		stop = true;
+	}
+	snapshot_submitted.notify_one();
+	writer_thread.join();
+}
+
+// get an empty buffer to take a snapshot into, or null if both buffers are still being written
+GeneticSimulation::CheckpointWriter* GeneticSimulation::AsyncCheckpointWriter::acquire_buffer()
+{
+	std::lock_guard<std::mutex> lock(mx);
+	for (auto& buffer : buffers) {
+		if (!buffer.in_use) {
+			buffer.in_use = true;
+			buffer.writer.clear();
+			return &buffer.writer;
+		}
+	}
+	return nullptr;
+}
+
+// submit a snapshot taken into an acquired buffer for writing, with the timestep it was
+// taken at and the time taken to take it
+void GeneticSimulation::AsyncCheckpointWriter::submit(CheckpointWriter* writer, unsigned int timestep,
+	double snapshot_ms)
+{
+	{
+		std::lock_guard<std::mutex> lock(mx);
+		for (size_t i = 0; i < buffers.size(); i++) {
+			if (&buffers[i].writer == writer) {
+				buffers[i].timestep = timestep;
+				buffers[i].snapshot_ms = snapshot_ms;
+				submitted.push_back(i);
+			}
+		}
+	}
+	snapshot_submitted.notify_one();
+}
+
+// wait until all submitted snapshots have been written
+void GeneticSimulation::AsyncCheckpointWriter::wait_until_idle()
+{
+	std::unique_lock<std::mutex> lock(mx);
+	snapshot_written.wait(lock, [&] { return !buffers[0].in_use && !buffers[1].in_use; });
+}
+
+// get path of checkpoint file for a timestep
+string GeneticSimulation::AsyncCheckpointWriter::get_path(unsigned int timestep) const
+{
+	return get_timestep_path(path, timestep);
+}
+
+// write submitted snapshots until stopped
+void GeneticSimulation::AsyncCheckpointWriter::run()
+{
+	while (true) {
+		// wait for a snapshot, or return once stopped and there are none left
+		size_t i;
+		{
+			std::unique_lock<std::mutex> lock(mx);
+			snapshot_submitted.wait(lock, [&] { return stop || !submitted.empty(); });
+			if (submitted.empty()) return;
+			i = submitted.front();
+			submitted.pop_front();
+		}
+
+		// write snapshot without holding mutex, so that the other buffer can be acquired meanwhile
+		write(buffers[i]);
+
+		// release buffer for the next snapshot
+		{
+			std::lock_guard<std::mutex> lock(mx);
+			buffers[i].in_use = false;
+		}
+		snapshot_written.notify_all();
+	}
+}
+
+// write a snapshot and remove checkpoints beyond the number to keep
+void GeneticSimulation::AsyncCheckpointWriter::write(Buffer& buffer)
+{
+	auto start = steady_clock::now();
+	auto checkpoint_path = get_path(buffer.timestep);
+	if (!write_checkpoint_file(checkpoint_path, buffer.writer.get_data())) return;
+	cout << "Wrote checkpoint " << checkpoint_path << " at timestep " << buffer.timestep << " ("
+		<< buffer.writer.get_data().size() / 1024 << " KiB, " << buffer.snapshot_ms << " ms snapshot, "
+		<< duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0 << " ms write)\n";
+
+	// rotate checkpoints, removing the oldest once more than the number to keep have been written
+	if (written.empty() || written.back() != checkpoint_path) {
+		written.push_back(checkpoint_path);
+	}
+	while (written.size() > keep) {
+		boost::system::error_code error;
+		boost::filesystem::remove(written.front(), error);
+		if (error) {
+			cerr << "Removing old checkpoint " << written.front() << " failed: " << error.message() << "\n";
+		}
+		written.pop_front();
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Checkpoint.h"
+#include <string>
+#include <deque>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace GeneticSimulation
+{
+	// Writes checkpoints on a background thread from two snapshot buffers, so that one
+	// snapshot can be taken while the previous one is still being written, naming each
+	// file by its timestep and keeping only the most recent checkpoints
+	class AsyncCheckpointWriter
+	{
+	public:
+
+		// constructor which takes the path checkpoint file names are based on and
+		// the number of most recent checkpoints to keep
+		AsyncCheckpointWriter(const std::string& path, unsigned int keep);
+
+		// destructor which finishes writing any submitted snapshots and stops the thread
+		~AsyncCheckpointWriter();
+
+		// get an empty buffer to take a snapshot into, or null if both buffers are
+		// still being written
+		CheckpointWriter* acquire_buffer();
+
+		// submit a snapshot taken into an acquired buffer for writing, with the timestep it
+		// was taken at and the time taken to take it
+		void submit(CheckpointWriter* buffer, unsigned int timestep, double snapshot_ms);
+
+		// wait until all submitted snapshots have been written
+		void wait_until_idle();
+
+		// get path of checkpoint file for a timestep
+		std::string get_path(unsigned int timestep) const;
+
+	private:
+
+		// snapshot buffer and the state of the snapshot in it
+		struct Buffer
+		{
+			CheckpointWriter writer;
+			bool in_use = false;
+			unsigned int timestep = 0;
+			double snapshot_ms = 0;
+		};
+
+		// write submitted snapshots until stopped
+		void run();
+
+		// write a snapshot and remove checkpoints beyond the number to keep
+		void write(Buffer& buffer);
+
+		// path checkpoint file names are based on and number of checkpoints to keep
+		const std::string path;
+		const unsigned int keep;
+		// snapshot buffers, and indices of submitted buffers in order of submission
+		std::array<Buffer, 2> buffers;
+		std::deque<std::size_t> submitted;
+		// paths of checkpoints written, oldest first
+		std::deque<std::string> written;
+		// whether thread should stop once all submitted snapshots have been written
+		bool stop;
+		// mutex and condition variables for submitting snapshots and waiting for them to be written
+		std::mutex mx;
+		std::condition_variable snapshot_submitted;
+		std::condition_variable snapshot_written;
+		// background thread writing checkpoints
+		std::thread writer_thread;
+	};
+}
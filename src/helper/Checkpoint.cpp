@@ -0,0 +1,173 @@
+#include "Checkpoint.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using std::string;
+using std::vector;
+using std::size_t;
+using std::cerr;
+using std::ios;
+
+// header at start of checkpoint file
+struct CheckpointHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t data_bytes;
+	uint64_t checksum;
+};
+
+// identifier and format version of checkpoint files (increment when the layout of any component changes)
+static const char checkpoint_magic[8] = "GSCHKPT";
+static const uint32_t checkpoint_version = 4;
+
+// 64-bit FNV-1a hash of checkpoint data, stored in the header so that partial or corrupted writes are detected
+static uint64_t checksum(const vector<char>& data)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (auto b : data) {
+		hash = (hash ^ static_cast<unsigned char>(b)) * 1099511628211ull;
+	}
+	return hash;
+}
+
+// write a string preceded by its length
+void GeneticSimulation::CheckpointWriter::write_string(const string& s)
+{
+	write<uint64_t>(s.size());
+	data.insert(data.end(), s.begin(), s.end());
+}
+
+// remove all data written, keeping capacity so that later checkpoints need not allocate
+void GeneticSimulation::CheckpointWriter::clear()
+{
+	data.clear();
+}
+
+// get data written
+const vector<char>& GeneticSimulation::CheckpointWriter::get_data() const
+{
+	return data;
+}
+
+// constructor which takes checkpoint data
+GeneticSimulation::CheckpointReader::CheckpointReader(const char* data, size_t size) :
+	data(data), size(size), position(0) {}
+
+// read a string written with its length
+string GeneticSimulation::CheckpointReader::read_string()
+{
+	auto length = read<uint64_t>();
+	if (length > size - position) {
+		throw std::runtime_error("checkpoint ends unexpectedly");
+	}
+	return string(take(length), length);
+}
+
+// get whether all data has been read
+bool GeneticSimulation::CheckpointReader::at_end() const
+{
+	return position == size;
+}
+
+// get path with a zero-padded timestep inserted before the extension, so that files written
+// at successive timesteps sort by timestep
+string GeneticSimulation::get_timestep_path(const string& path, unsigned int timestep)
+{
+	boost::filesystem::path timestep_path(path);
+	std::ostringstream filename;
+	filename << timestep_path.stem().string() << "_" << std::setw(10) << std::setfill('0') << timestep
+		<< timestep_path.extension().string();
+	return (timestep_path.parent_path() / filename.str()).string();
+}
+
+// write checkpoint data to a file after a versioned header, atomically replacing any existing file
+bool GeneticSimulation::write_checkpoint_file(const string& path, const vector<char>& data)
+{
+	namespace fs = boost::filesystem;
+	try {
+		// write to a uniquely named temporary file so that a crash never leaves a partial
+		// checkpoint in place of the previous one, then rename over checkpoint file
+		fs::path checkpoint_path(path);
+		auto directory = checkpoint_path.parent_path().empty() ? fs::path(".") : checkpoint_path.parent_path();
+		fs::create_directories(directory);
+		auto temporary_path = directory / fs::unique_path(checkpoint_path.filename().string() + ".%%%%%%%%.tmp");
+		{
+			fs::ofstream checkpoint_file(temporary_path, ios::binary | ios::trunc);
+			if (!checkpoint_file) {
+				cerr << "Writing checkpoint failed: Check that the path exists and may be written to\n";
+				return false;
+			}
+			CheckpointHeader header = {};
+			std::memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+			header.version = checkpoint_version;
+			header.data_bytes = data.size();
+			header.checksum = checksum(data);
+			checkpoint_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			checkpoint_file.write(data.data(), data.size());
+			if (!checkpoint_file) {
+				cerr << "Writing checkpoint failed\n";
+				checkpoint_file.close();
+				fs::remove(temporary_path);
+				return false;
+			}
+		}
+		fs::rename(temporary_path, checkpoint_path);
+		return true;
+	}
+	catch (const fs::filesystem_error& e) {
+		cerr << "Writing checkpoint failed: " << e.what() << "\n";
+		return false;
+	}
+}
+
+// read checkpoint data from a file in one sequential read after checking its header, then check its checksum
+bool GeneticSimulation::read_checkpoint_file(const string& path, vector<char>& data)
+{
+	namespace fs = boost::filesystem;
+	try {
+		fs::ifstream checkpoint_file(path, ios::binary);
+		if (!checkpoint_file) {
+			cerr << "Reading checkpoint failed: " << path << " could not be opened\n";
+			return false;
+		}
+
+		// check header identifies a checkpoint of this version whose data is all present
+		CheckpointHeader header;
+		checkpoint_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!checkpoint_file || std::memcmp(header.magic, checkpoint_magic, sizeof(header.magic)) != 0) {
+			cerr << "Reading checkpoint failed: " << path << " is not a checkpoint\n";
+			return false;
+		}
+		if (header.version != checkpoint_version) {
+			cerr << "Reading checkpoint failed: " << path << " has version " << header.version
+				<< " but version " << checkpoint_version << " is supported\n";
+			return false;
+		}
+		if (fs::file_size(path) != sizeof(header) + header.data_bytes) {
+			cerr << "Reading checkpoint failed: " << path << " is incomplete\n";
+			return false;
+		}
+
+		// read data
+		data.resize(header.data_bytes);
+		checkpoint_file.read(data.data(), data.size());
+		if (!checkpoint_file) {
+			cerr << "Reading checkpoint failed: " << path << " could not be read\n";
+			return false;
+		}
+		if (checksum(data) != header.checksum) {
+			cerr << "Reading checkpoint failed: " << path << " does not match its checksum\n";
+			return false;
+		}
+		return true;
+	}
+	catch (const fs::filesystem_error& e) {
+		cerr << "Reading checkpoint failed: " << e.what() << "\n";
+		return false;
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace GeneticSimulation
+{
+	// Appends the state of simulation components to an in-memory binary checkpoint
+	class CheckpointWriter
+	{
+	public:
+
+		// write a trivially copyable value
+		template<class T>
+		void write(const T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+			auto bytes = reinterpret_cast<const char*>(&value);
+			data.insert(data.end(), bytes, bytes + sizeof(T));
+		}
+
+		// write a vector of trivially copyable values preceded by its size
+		template<class T>
+		void write_vector(const std::vector<T>& values) {
+			static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+			write<uint64_t>(values.size());
+			auto bytes = reinterpret_cast<const char*>(values.data());
+			data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+		}
+
+		// write a string preceded by its length
+		void write_string(const std::string& s);
+
+		// remove all data written, keeping capacity so that later checkpoints need not allocate
+		void clear();
+
+		// get data written
+		const std::vector<char>& get_data() const;
+
+	private:
+
+		// checkpoint data
+		std::vector<char> data;
+	};
+
+	// Reads the state of simulation components back from a binary checkpoint, throwing 
+	// std::runtime_error if the checkpoint ends early or does not match the components
+	class CheckpointReader
+	{
+	public:
+
+		// constructor which takes checkpoint data
+		CheckpointReader(const char* data, std::size_t size);
+
+		// read a trivially copyable value
+		template<class T>
+		void read(T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+			std::memcpy(&value, take(sizeof(T)), sizeof(T));
+		}
+
+		// read and return a trivially copyable value
+		template<class T>
+		T read() {
+			T value;
+			read(value);
+			return value;
+		}
+
+		// read a vector of trivially copyable values into an existing vector of the same size
+		template<class T>
+		void read_vector(std::vector<T>& values) {
+			static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+			if (read<uint64_t>() != values.size()) {
+				throw std::runtime_error("checkpoint vector size does not match config");
+			}
+			if (!values.empty()) {
+				std::memcpy(values.data(), take(values.size() * sizeof(T)), values.size() * sizeof(T));
+			}
+		}
+
+		// read a string written with its length
+		std::string read_string();
+
+		// get whether all data has been read
+		bool at_end() const;
+
+	private:
+
+		// get pointer to the next bytes of data and advance past them
+		const char* take(std::size_t bytes) {
+			if (bytes > size - position) {
+				throw std::runtime_error("checkpoint ends unexpectedly");
+			}
+			auto p = data + position;
+			position += bytes;
+			return p;
+		}
+
+		// checkpoint data and position of next byte to read
+		const char* data;
+		std::size_t size;
+		std::size_t position;
+	};
+
+	// get path with a zero-padded timestep inserted before the extension, so that files written
+	// at successive timesteps sort by timestep
+	std::string get_timestep_path(const std::string& path, unsigned int timestep);
+
+	// write checkpoint data to a file after a versioned header with a checksum of the data,
+	// atomically replacing any existing file, returning whether successful
+	bool write_checkpoint_file(const std::string& path, const std::vector<char>& data);
+
+	// read checkpoint data from a file in one sequential read after checking its header and
+	// checksum, returning whether successful
+	bool read_checkpoint_file(const std::string& path, std::vector<char>& data);
+}
@@ -1,22 +1,38 @@
 #pragma once
 
-#include <queue>
+#include <vector>
 #include <mutex>
+#include <cstddef>
+#include <algorithm>
 
 namespace GeneticSimulation
 {
-	// A simple extension of a queue allowing thread-safe pushes and pops
+	// A simple FIFO queue allowing thread-safe pushes and pops, stored in a ring
+	// buffer so that pushes and pops never allocate once capacity is reserved
 	template<typename T>
 	class ConcurrentQueue
 	{
 	public:
 
+		// reserve space for the given number of items
+		void reserve(std::size_t capacity) {
+			// lock mutex
+			std::scoped_lock lock(mx);
+			// grow ring buffer
+			grow(capacity);
+		}
+
 		// thread-safe push
 		void safe_push(T item) {
 			// lock mutex
 			std::scoped_lock lock(mx);
+			// double capacity if full
+			if (count == items.size()) {
+				grow(std::max<std::size_t>(1, items.size() * 2));
+			}
 			// push item
-			q.push(item);
+			items[(head + count) % items.size()] = item;
+			count++;
 		}
 
 		// thread-safe pop which pops an item off if available and applies the
@@ -26,15 +42,16 @@ namespace GeneticSimulation
 			// lock mutex
 			std::unique_lock lock(mx);
 			// return false if queue is empty
-			if (q.empty()) {
+			if (count == 0) {
 				return false;
 			}
 			// pop and apply callable object otherwise
 			else {
 				// get item
-				T item = q.front();
+				T item = items[head];
 				// pop item
-				q.pop();
+				head = (head + 1) % items.size();
+				count--;
 				// unlock mutex
 				lock.unlock();
 				// apply given callable object to popped item
@@ -44,16 +61,52 @@ namespace GeneticSimulation
 			}
 		}
 
-		// provide access to the underlying queue
-		std::queue<T>& get_queue() {
-			return q;
+		// get number of items which may be queued without allocating
+		std::size_t get_capacity() {
+			// lock mutex
+			std::scoped_lock lock(mx);
+			return items.size();
+		}
+
+		// copy queued items in order from front to back
+		void get_items(std::vector<T>& queued) {
+			// lock mutex
+			std::scoped_lock lock(mx);
+			queued.resize(count);
+			for (std::size_t i = 0; i < count; i++) {
+				queued[i] = items[(head + i) % items.size()];
+			}
+		}
+
+		// replace queued items with the given items in order from front to back
+		void assign_items(const std::vector<T>& queued) {
+			// lock mutex
+			std::scoped_lock lock(mx);
+			grow(queued.size());
+			head = 0;
+			count = queued.size();
+			std::copy(queued.begin(), queued.end(), items.begin());
 		}
 
 	private:
 
+		// move items into a larger ring buffer (mutex must be held)
+		void grow(std::size_t capacity) {
+			if (capacity <= items.size()) return;
+			std::vector<T> grown(capacity);
+			for (std::size_t i = 0; i < count; i++) {
+				grown[i] = items[(head + i) % items.size()];
+			}
+			items.swap(grown);
+			head = 0;
+		}
+
 		// mutex protecting queue
 		std::mutex mx;
-		// queue
-		std::queue<T> q;
+		// ring buffer of items
+		std::vector<T> items;
+		// index of front item and number of items
+		std::size_t head = 0;
+		std::size_t count = 0;
 	};
-}
\ No newline at end of file
+}
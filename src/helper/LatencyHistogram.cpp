@@ -0,0 +1,53 @@
+#include "LatencyHistogram.h"
+#include <string>
+
+using std::array;
+using std::string;
+using std::to_string;
+using std::memory_order_relaxed;
+
+// upper bound of each finite bucket in microseconds
+const array<unsigned long long, GeneticSimulation::LatencyHistogram::num_bounds>
+	GeneticSimulation::LatencyHistogram::bounds = {
+		1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 100000
+	};
+
+// constructor
+GeneticSimulation::LatencyHistogram::LatencyHistogram() : sum(0), count(0)
+{
+	for (auto& b : buckets) {
+		b.store(0, memory_order_relaxed);
+	}
+}
+
+// record a duration in microseconds
+void GeneticSimulation::LatencyHistogram::record(unsigned long long microseconds)
+{
+	// find first bucket whose upper bound contains the duration
+	unsigned int i = 0;
+	while (i < num_bounds && microseconds > bounds[i]) {
+		i++;
+	}
+	// update bucket, sum and count
+	buckets[i].fetch_add(1, memory_order_relaxed);
+	sum.fetch_add(microseconds, memory_order_relaxed);
+	count.fetch_add(1, memory_order_relaxed);
+}
+
+// append histogram in Prometheus text format with the given metric name and labels
+void GeneticSimulation::LatencyHistogram::render(string& out, const string& name, const string& labels) const
+{
+	// prefix for label set of each bucket
+	string label_prefix = labels.empty() ? "" : labels + ",";
+	// write cumulative buckets with bounds in seconds
+	unsigned long long cumulative = 0;
+	for (unsigned int i = 0; i <= num_bounds; i++) {
+		cumulative += buckets[i].load(memory_order_relaxed);
+		string le = i < num_bounds ? to_string(bounds[i] / 1e6) : "+Inf";
+		out += name + "_bucket{" + label_prefix + "le=\"" + le + "\"} " + to_string(cumulative) + "\n";
+	}
+	// write sum in seconds and count
+	string label_set = labels.empty() ? "" : "{" + labels + "}";
+	out += name + "_sum" + label_set + " " + to_string(sum.load(memory_order_relaxed) / 1e6) + "\n";
+	out += name + "_count" + label_set + " " + to_string(count.load(memory_order_relaxed)) + "\n";
+}
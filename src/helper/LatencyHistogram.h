@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace GeneticSimulation
+{
+	// A histogram of durations with fixed microsecond buckets, which may be
+	// recorded into from one thread and read from another without locking
+	class LatencyHistogram
+	{
+	public:
+
+		// number of buckets with a finite upper bound
+		static constexpr unsigned int num_bounds = 14;
+
+		// constructor
+		LatencyHistogram();
+
+		// record a duration in microseconds
+		void record(unsigned long long microseconds);
+
+		// append histogram in Prometheus text format with the given metric name and labels
+		void render(std::string& out, const std::string& name, const std::string& labels) const;
+
+	private:
+
+		// upper bound of each finite bucket in microseconds
+		static const std::array<unsigned long long, num_bounds> bounds;
+
+		// count of durations in each bucket (non-cumulative), with the last bucket unbounded
+		std::array<std::atomic<unsigned long long>, num_bounds + 1> buckets;
+		// sum of all recorded durations in microseconds
+		std::atomic<unsigned long long> sum;
+		// number of recorded durations
+		std::atomic<unsigned long long> count;
+	};
+}
@@ -0,0 +1,83 @@
+#include "MemoryFootprint.h"
+#include <iomanip>
+#include <algorithm>
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::size_t;
+using std::ostream;
+using std::setw;
+using std::left;
+using std::right;
+using std::fixed;
+using std::setprecision;
+using std::find_if;
+
+// format a number of bytes in mebibytes
+static double to_mib(size_t bytes)
+{
+	return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+// add bytes to a component, creating it if necessary
+void GeneticSimulation::MemoryFootprint::add(const string& component, size_t bytes)
+{
+	auto it = find_if(components.begin(), components.end(),
+		[&](const pair<string, size_t>& c) { return c.first == component; });
+	if (it == components.end()) {
+		components.emplace_back(component, bytes);
+	}
+	else {
+		it->second += bytes;
+	}
+}
+
+// get bytes used by a component (0 if not present)
+size_t GeneticSimulation::MemoryFootprint::get(const string& component) const
+{
+	auto it = find_if(components.begin(), components.end(),
+		[&](const pair<string, size_t>& c) { return c.first == component; });
+	return it == components.end() ? 0 : it->second;
+}
+
+// get total bytes across all components
+size_t GeneticSimulation::MemoryFootprint::get_total() const
+{
+	size_t total = 0;
+	for (auto& c : components) {
+		total += c.second;
+	}
+	return total;
+}
+
+// get components in the order they were added
+const vector<pair<string, size_t>>& GeneticSimulation::MemoryFootprint::get_components() const
+{
+	return components;
+}
+
+// print breakdown with a title, optionally alongside another footprint for comparison
+void GeneticSimulation::MemoryFootprint::print(ostream& out, const string& title,
+	const MemoryFootprint* comparison, const string& comparison_title) const
+{
+	// save stream format flags so they can be restored
+	auto flags = out.flags();
+	auto precision = out.precision();
+	// print header
+	out << left << setw(28) << "Memory (MiB)" << right << setw(14) << title;
+	if (comparison) out << setw(14) << comparison_title;
+	out << "\n" << fixed << setprecision(3);
+	// print each component
+	for (auto& c : components) {
+		out << "  " << left << setw(26) << c.first << right << setw(14) << to_mib(c.second);
+		if (comparison) out << setw(14) << to_mib(comparison->get(c.first));
+		out << "\n";
+	}
+	// print total
+	out << "  " << left << setw(26) << "total" << right << setw(14) << to_mib(get_total());
+	if (comparison) out << setw(14) << to_mib(comparison->get_total());
+	out << "\n";
+	out.flags(flags);
+	out.precision(precision);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <ostream>
+
+namespace GeneticSimulation
+{
+	// A breakdown of memory usage in bytes by named component
+	class MemoryFootprint
+	{
+	public:
+
+		// add bytes to a component, creating it if necessary
+		void add(const std::string& component, std::size_t bytes);
+
+		// get bytes used by a component (0 if not present)
+		std::size_t get(const std::string& component) const;
+
+		// get total bytes across all components
+		std::size_t get_total() const;
+
+		// get components in the order they were added
+		const std::vector<std::pair<std::string, std::size_t>>& get_components() const;
+
+		// print breakdown with a title, optionally alongside another footprint for comparison
+		void print(std::ostream& out, const std::string& title,
+			const MemoryFootprint* comparison = nullptr, const std::string& comparison_title = "") const;
+
+	private:
+
+		// bytes used by each component
+		std::vector<std::pair<std::string, std::size_t>> components;
+	};
+}
@@ -0,0 +1,93 @@
+#include "MetricsServer.h"
+#include <iostream>
+#include <string>
+#include <memory>
+
+using std::string;
+using std::to_string;
+using std::shared_ptr;
+using std::make_shared;
+using std::cout;
+using std::cerr;
+using boost::asio::ip::tcp;
+
+// constructor which takes the address and port to bind to and
+// a callable object which generates the metrics page
+GeneticSimulation::MetricsServer::MetricsServer(const string& address, unsigned short port,
+	std::function<string()> generate_page) :
+	address(address), port(port), generate_page(generate_page), acceptor(io) {}
+
+// destructor which stops the server thread
+GeneticSimulation::MetricsServer::~MetricsServer()
+{
+	io.stop();
+	if (server_thread.joinable()) {
+		server_thread.join();
+	}
+}
+
+// start accepting connections on the background thread
+bool GeneticSimulation::MetricsServer::start()
+{
+	// attempt to bind to address and port
+	try {
+		tcp::endpoint endpoint(boost::asio::ip::make_address(address), port);
+		acceptor.open(endpoint.protocol());
+		acceptor.set_option(tcp::acceptor::reuse_address(true));
+		acceptor.bind(endpoint);
+		acceptor.listen();
+	}
+	catch (const boost::system::system_error& e) {
+		// if binding fails, log error and leave server stopped
+		cerr << "Starting metrics server failed: " << e.what() << "\n";
+		return false;
+	}
+
+	cout << "Serving metrics on http://" << address << ":" << port << "/metrics\n";
+
+	// queue first accept and run I/O context on background thread
+	accept();
+	server_thread = boost::thread([this] { io.run(); });
+	return true;
+}
+
+// accept the next connection
+void GeneticSimulation::MetricsServer::accept()
+{
+	auto connection = make_shared<Connection>(io);
+	acceptor.async_accept(connection->socket,
+		[this, connection](const boost::system::error_code& ec) {
+			if (!ec) {
+				serve(connection);
+			}
+			// keep accepting until I/O context is stopped
+			if (ec != boost::asio::error::operation_aborted) {
+				accept();
+			}
+		}
+	);
+}
+
+// read request and respond on a connection
+void GeneticSimulation::MetricsServer::serve(shared_ptr<Connection> connection)
+{
+	// read request headers (the request itself is ignored)
+	boost::asio::async_read_until(connection->socket, connection->request, "\r\n\r\n",
+		[this, connection](const boost::system::error_code& ec, std::size_t) {
+			if (ec) return;
+			// generate page and response
+			auto page = generate_page();
+			connection->response = "HTTP/1.0 200 OK\r\n"
+				"Content-Type: text/plain; version=0.0.4\r\n"
+				"Content-Length: " + to_string(page.size()) + "\r\n"
+				"Connection: close\r\n\r\n" + page;
+			// write response and close connection
+			boost::asio::async_write(connection->socket, boost::asio::buffer(connection->response),
+				[connection](const boost::system::error_code&, std::size_t) {
+					boost::system::error_code ignored;
+					connection->socket.shutdown(tcp::socket::shutdown_both, ignored);
+				}
+			);
+		}
+	);
+}
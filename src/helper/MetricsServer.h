@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <boost/asio.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace GeneticSimulation
+{
+	// A minimal HTTP server which responds to every request with a plain
+	// text metrics page, serving all connections on a single background thread
+	class MetricsServer
+	{
+	public:
+
+		// constructor which takes the address and port to bind to and
+		// a callable object which generates the metrics page
+		MetricsServer(const std::string& address, unsigned short port,
+			std::function<std::string()> generate_page);
+
+		// destructor which stops the server thread
+		~MetricsServer();
+
+		// start accepting connections on the background thread
+		bool start();
+
+	private:
+
+		// state of a single connection
+		struct Connection
+		{
+			explicit Connection(boost::asio::io_context& io) : socket(io) {}
+			boost::asio::ip::tcp::socket socket;
+			boost::asio::streambuf request;
+			std::string response;
+		};
+
+		// accept the next connection
+		void accept();
+
+		// read request and respond on a connection
+		void serve(std::shared_ptr<Connection> connection);
+
+		// address and port to bind to
+		const std::string address;
+		const unsigned short port;
+		// callable object which generates metrics page
+		std::function<std::string()> generate_page;
+		// I/O context and acceptor
+		boost::asio::io_context io;
+		boost::asio::ip::tcp::acceptor acceptor;
+		// background thread running I/O context
+		boost::thread server_thread;
+	};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+namespace GeneticSimulation
+{
+	// A bounded lock-free FIFO queue for one producer thread and one consumer thread at a time,
+	// stored in a ring buffer allocated once so that pushes and pops never block or allocate
+	// (a different thread may take over either role if it synchronizes with the previous one)
+	template<typename T>
+	class SpscQueue
+	{
+	public:
+
+		// constructor which takes the minimum capacity, rounded up to a power of two
+		explicit SpscQueue(std::size_t min_capacity) : head(0), tail(0) {
+			std::size_t capacity = 1;
+			while (capacity < min_capacity) capacity *= 2;
+			items.resize(capacity);
+			mask = capacity - 1;
+		}
+
+		// push an item if there is space, returning whether it was pushed (producer only)
+		bool try_push(const T& item) {
+			auto t = tail.load(std::memory_order_relaxed);
+			if (t - head.load(std::memory_order_acquire) == items.size()) return false;
+			items[t & mask] = item;
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		// pop the oldest item if there is one, returning whether an item was popped (consumer only)
+		bool try_pop(T& item) {
+			auto h = head.load(std::memory_order_relaxed);
+			if (h == tail.load(std::memory_order_acquire)) return false;
+			item = items[h & mask];
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		// get maximum number of items
+		std::size_t get_capacity() const {
+			return items.size();
+		}
+
+	private:
+
+		// ring buffer of items and mask for wrapping positions
+		std::vector<T> items;
+		std::size_t mask;
+		// positions of the next item to pop and push, which only increase, on separate cache
+		// lines so that the producer and consumer do not contend
+		alignas(64) std::atomic<std::size_t> head;
+		alignas(64) std::atomic<std::size_t> tail;
+	};
+}
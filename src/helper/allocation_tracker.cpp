@@ -0,0 +1,121 @@
+#include "allocation_tracker.h"
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+#ifdef TRACK_ALLOCATIONS
+
+namespace
+{
+	// number of allocations and bytes allocated by this thread (plain
+	// thread-local integers so that counting never allocates or locks)
+	thread_local unsigned long long thread_allocation_count = 0;
+	thread_local unsigned long long thread_allocated_bytes = 0;
+
+	// allocate and count, returning null on failure
+	void* counted_malloc(std::size_t size)
+	{
+		thread_allocation_count++;
+		thread_allocated_bytes += size;
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	// allocate aligned memory and count, returning null on failure
+	void* counted_aligned_malloc(std::size_t size, std::size_t alignment)
+	{
+		thread_allocation_count++;
+		thread_allocated_bytes += size;
+		// round size up to a multiple of alignment as required by aligned_alloc
+		size = ((size == 0 ? 1 : size) + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+		return _aligned_malloc(size, alignment);
+#else
+		return std::aligned_alloc(alignment, size);
+#endif
+	}
+
+	// free aligned memory
+	void aligned_free(void* p)
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+}
+
+// replacement global allocation functions which count allocations per thread
+
+void* operator new(std::size_t size)
+{
+	if (void* p = counted_malloc(size)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	if (void* p = counted_malloc(size)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_malloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	if (void* p = counted_aligned_malloc(size, static_cast<std::size_t>(alignment))) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	if (void* p = counted_aligned_malloc(size, static_cast<std::size_t>(alignment))) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+
+// get number of heap allocations made by the calling thread
+unsigned long long GeneticSimulation::get_thread_allocation_count()
+{
+	return thread_allocation_count;
+}
+
+// get number of bytes allocated on the heap by the calling thread
+unsigned long long GeneticSimulation::get_thread_allocated_bytes()
+{
+	return thread_allocated_bytes;
+}
+
+#else
+
+// get number of heap allocations made by the calling thread (0 as tracking is disabled)
+unsigned long long GeneticSimulation::get_thread_allocation_count()
+{
+	return 0;
+}
+
+// get number of bytes allocated on the heap by the calling thread (0 as tracking is disabled)
+unsigned long long GeneticSimulation::get_thread_allocated_bytes()
+{
+	return 0;
+}
+
+#endif
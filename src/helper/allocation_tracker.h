@@ -0,0 +1,17 @@
+#pragma once
+
+namespace GeneticSimulation
+{
+	// whether global operator new is instrumented to count heap allocations
+#ifdef TRACK_ALLOCATIONS
+	constexpr bool allocation_tracking_enabled = true;
+#else
+	constexpr bool allocation_tracking_enabled = false;
+#endif
+
+	// get number of heap allocations made by the calling thread (0 if tracking is disabled)
+	unsigned long long get_thread_allocation_count();
+
+	// get number of bytes allocated on the heap by the calling thread (0 if tracking is disabled)
+	unsigned long long get_thread_allocated_bytes();
+}
@@ -0,0 +1,26 @@
+#include "memory_usage.h"
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+// get resident set size of the current process in bytes (0 if unsupported)
+std::size_t GeneticSimulation::get_resident_set_size()
+{
+#if defined(__linux__)
+	// second field of statm is resident pages
+	std::ifstream statm("/proc/self/statm");
+	std::size_t total_pages = 0, resident_pages = 0;
+	if (!(statm >> total_pages >> resident_pages)) return 0;
+	return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#elif defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+	return counters.WorkingSetSize;
+#else
+	return 0;
+#endif
+}
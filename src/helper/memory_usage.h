@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+namespace GeneticSimulation
+{
+	// get resident set size of the current process in bytes (0 if unsupported)
+	std::size_t get_resident_set_size();
+}
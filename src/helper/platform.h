@@ -5,4 +5,18 @@
 #define GPU_SUPPORT 1
 #elif defined(_WIN64)
 #define GPU_SUPPORT 1
+#endif
+
+// compile vectorizable kernels for several instruction sets, selected at run time
+// (GCC on x86-64 Linux only, elsewhere kernels are compiled for the default target)
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define SIMD_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SIMD_TARGET_CLONES
+#endif
+
+// share precomputed temperatures between processes through named POSIX shared memory (Linux only,
+// where segments are files in a tmpfs that can be locked with flock)
+#if defined(__linux__)
+#define SHARED_MEMORY_SUPPORT 1
 #endif
\ No newline at end of file
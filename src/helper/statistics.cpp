@@ -0,0 +1,76 @@
+#include "statistics.h"
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+using std::sort;
+using std::max;
+using std::min;
+using std::abs;
+using std::sqrt;
+using std::exp;
+
+// calculate the mean of a sample (0 if empty)
+double GeneticSimulation::sample_mean(const vector<double>& sample)
+{
+	if (sample.empty()) return 0;
+	double sum = 0;
+	for (auto x : sample) {
+		sum += x;
+	}
+	return sum / sample.size();
+}
+
+// calculate the unbiased standard deviation of a sample (0 if fewer than 2 values)
+double GeneticSimulation::sample_standard_deviation(const vector<double>& sample)
+{
+	if (sample.size() < 2) return 0;
+	double mean = sample_mean(sample);
+	double sum_squares = 0;
+	for (auto x : sample) {
+		sum_squares += (x - mean) * (x - mean);
+	}
+	return sqrt(sum_squares / (sample.size() - 1));
+}
+
+// calculate the two-sample Kolmogorov-Smirnov statistic, i.e. the largest
+// difference between the empirical distribution functions of two samples
+double GeneticSimulation::kolmogorov_smirnov_statistic(vector<double> a, vector<double> b)
+{
+	if (a.empty() || b.empty()) return 0;
+	sort(a.begin(), a.end());
+	sort(b.begin(), b.end());
+	// walk both sorted samples, stepping past all copies of the smallest remaining value
+	// so that tied values move both distribution functions together
+	size_t i = 0, j = 0;
+	double d = 0;
+	while (i < a.size() && j < b.size()) {
+		double x = min(a[i], b[j]);
+		while (i < a.size() && a[i] == x) i++;
+		while (j < b.size() && b[j] == x) j++;
+		d = max(d, abs(static_cast<double>(i) / a.size() - static_cast<double>(j) / b.size()));
+	}
+	return d;
+}
+
+// calculate the asymptotic p-value of the two-sample Kolmogorov-Smirnov test
+// for the hypothesis that two samples are drawn from the same distribution
+double GeneticSimulation::kolmogorov_smirnov_p_value(const vector<double>& a, const vector<double>& b)
+{
+	if (a.empty() || b.empty()) return 1;
+	double d = kolmogorov_smirnov_statistic(a, b);
+	// effective sample size, with small-sample correction to the Kolmogorov distribution
+	double n = static_cast<double>(a.size()) * b.size() / (a.size() + b.size());
+	double lambda = (sqrt(n) + 0.12 + 0.11 / sqrt(n)) * d;
+	// Q(lambda) = 2 * sum over k of (-1)^(k-1) exp(-2 k^2 lambda^2), which tends to 1 as lambda tends to 0
+	if (lambda < 1e-3) return 1;
+	double sum = 0;
+	double sign = 1;
+	for (int k = 1; k <= 100; k++) {
+		double term = sign * exp(-2 * k * k * lambda * lambda);
+		sum += term;
+		if (abs(term) < 1e-10) break;
+		sign = -sign;
+	}
+	return min(1.0, max(0.0, 2 * sum));
+}
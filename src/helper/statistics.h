@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+namespace GeneticSimulation
+{
+	// calculate the mean of a sample (0 if empty)
+	double sample_mean(const std::vector<double>& sample);
+
+	// calculate the unbiased standard deviation of a sample (0 if fewer than 2 values)
+	double sample_standard_deviation(const std::vector<double>& sample);
+
+	// calculate the two-sample Kolmogorov-Smirnov statistic, i.e. the largest
+	// difference between the empirical distribution functions of two samples
+	double kolmogorov_smirnov_statistic(std::vector<double> a, std::vector<double> b);
+
+	// calculate the asymptotic p-value of the two-sample Kolmogorov-Smirnov test
+	// for the hypothesis that two samples are drawn from the same distribution
+	double kolmogorov_smirnov_p_value(const std::vector<double>& a, const std::vector<double>& b);
+}
@@ -12,7 +12,5 @@ int main(int argc, char* argv[])
 	Simulation simulation(config);
 	simulation.init();
 	// run simulation
-	simulation.run();
-
-	return 0;
+	return simulation.run();
 }
\ No newline at end of file
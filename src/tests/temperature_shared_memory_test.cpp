@@ -0,0 +1,127 @@
+// Starts several processes at the same moment, each attaching to the same shared temperature table
+// as the seeds of a multi-process ensemble do, and checks that exactly one publishes it, that the
+// others attach as soon as it is published (rather than once the publisher exits), that every process
+// reads the published table and that the segment is removed when the last process exits
+
+#include "../TemperatureSharedMemory.h"
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+using namespace GeneticSimulation;
+using std::cout;
+using std::cerr;
+
+// number of processes started together
+static const int processes = 4;
+// time the publisher takes to compute the table, and time every process stays attached
+static const auto compute_time = std::chrono::milliseconds(300);
+static const auto run_time = std::chrono::milliseconds(2000);
+// longest time a process may wait for the table (well below the time the publisher stays attached)
+static const auto max_wait_time = std::chrono::milliseconds(1500);
+
+// exit codes of a process
+enum process_result { published = 0, attached = 1, wrong_table = 2, waited_too_long = 3 };
+
+// attach to the table, publishing it if no other process has, then stay attached for a run
+static int run_process(const Config& config, int start_pipe)
+{
+	// wait until every process has been started
+	char c;
+	while (read(start_pipe, &c, 1) > 0) {}
+	auto start = std::chrono::steady_clock::now();
+
+	// attach or publish table holding the timestep in each cell
+	std::vector<float> table(static_cast<size_t>(config.area_height) * config.orbital_period);
+	for (size_t i = 0; i < table.size(); i++) table[i] = static_cast<float>(i % config.orbital_period);
+	TemperatureSharedMemory shared(config, full_storage);
+	double offset = 0.0, scale = 0.0;
+	auto data = shared.attach(table.size() * sizeof(float), offset, scale);
+	int result = attached;
+	if (!data) {
+		std::this_thread::sleep_for(compute_time);
+		data = shared.publish(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(float), 1.0, 2.0);
+		result = published;
+	}
+	auto wait_time = std::chrono::steady_clock::now() - start;
+
+	// check table and how long it took to get it
+	auto values = reinterpret_cast<const float*>(data);
+	if (!data || (result == attached && (offset != 1.0 || scale != 2.0))) return wrong_table;
+	for (size_t i = 0; i < table.size(); i++) {
+		if (values[i] != table[i]) return wrong_table;
+	}
+	if (wait_time > max_wait_time) return waited_too_long;
+
+	// stay attached for the rest of the run
+	std::this_thread::sleep_for(run_time);
+	return result;
+}
+
+int main()
+{
+	// name segment uniquely to this test run by the parameters hashed into its name
+	Config config{};
+	config.area_height = 16;
+	config.orbital_period = 64;
+	config.star_luminosity = static_cast<double>(getpid());
+	std::string name;
+	{
+		// the only process attached removes the segment again when it detaches
+		TemperatureSharedMemory probe(config, full_storage);
+		name = probe.get_name();
+	}
+
+	// start processes, which each block on the pipe until it is closed
+	int start_pipe[2];
+	if (pipe(start_pipe) != 0) {
+		cerr << "Creating pipe failed\n";
+		return 1;
+	}
+	std::vector<pid_t> children;
+	for (int i = 0; i < processes; i++) {
+		auto pid = fork();
+		if (pid == 0) {
+			close(start_pipe[1]);
+			_exit(run_process(config, start_pipe[0]));
+		}
+		children.push_back(pid);
+	}
+	close(start_pipe[0]);
+	close(start_pipe[1]);
+
+	// count how each process attached
+	int publishers = 0, attachers = 0, failures = 0;
+	for (auto pid : children) {
+		int status = 0;
+		waitpid(pid, &status, 0);
+		int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+		if (code == published) publishers++;
+		else if (code == attached) attachers++;
+		else {
+			failures++;
+			cerr << "Process " << pid << (code == wrong_table ? " read the wrong table" :
+				code == waited_too_long ? " waited too long for the table" : " failed") << "\n";
+		}
+	}
+	cout << publishers << " published and " << attachers << " attached of " << processes << " processes\n";
+
+	// segment and its publish lock must have been removed by the last process to detach
+	bool removed = true;
+	for (auto segment : { name, name + "_lock" }) {
+		auto descriptor = shm_open(segment.c_str(), O_RDONLY, 0);
+		if (descriptor != -1) {
+			cerr << "Shared memory " << segment << " was not removed\n";
+			close(descriptor);
+			shm_unlink(segment.c_str());
+			removed = false;
+		}
+	}
+	return failures == 0 && publishers == 1 && attachers == processes - 1 && removed ? 0 : 1;
+}